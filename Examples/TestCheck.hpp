@@ -0,0 +1,11 @@
+#pragma once
+
+#include <iostream>
+
+// Print one result line of a test; returns `passed` so results can be
+// collected with ok &= check(...)
+inline bool check(const char *what, bool passed)
+{
+    std::cout << (passed ? "  ok   " : "  FAIL ") << what << "\n";
+    return passed;
+}
@@ -0,0 +1,97 @@
+#include "../Includes/Logger.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// Multi-threaded logging benchmark: reports the average cost of a logging
+// call as seen by each producer thread.
+//
+//   filtered - message below the log level (hot read-only path)
+//   sync     - handler called on the logging thread
+//   async    - record queued for the backend thread
+
+static const int MESSAGES_PER_THREAD = 200000;
+
+static double runThreads(int threadCount, LogLevel level)
+{
+    std::atomic<int> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> threads;
+    std::vector<double> nsPerCall(threadCount);
+
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&, t]
+                             {
+            ready.fetch_add(1);
+            while (!go.load())
+            {
+                std::this_thread::yield();
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < MESSAGES_PER_THREAD; ++i)
+            {
+                if (level == LogLevel::DEBUG1)
+                {
+                    LOG_CPP_DEBUG1("Filtered message ", i, " from thread ", t);
+                }
+                else
+                {
+                    LOG_CPP_INFO("Benchmark message ", i, " from thread ", t);
+                }
+            }
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            nsPerCall[t] = std::chrono::duration<double, std::nano>(elapsed).count() / MESSAGES_PER_THREAD; });
+    }
+
+    while (ready.load() < threadCount)
+    {
+        std::this_thread::yield();
+    }
+    go.store(true);
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    double total = 0;
+    for (double ns : nsPerCall)
+    {
+        total += ns;
+    }
+    return total / threadCount;
+}
+
+int main()
+{
+    Logger::initialize("Bench", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+
+    // Count messages instead of printing them
+    std::atomic<uint64_t> handled(0);
+    logger->setHandler([&handled](const LogEntry &)
+                       { handled.fetch_add(1, std::memory_order_relaxed); });
+
+    const int threadCounts[] = {1, 2, 4, 8};
+
+    std::printf("=== LOG4CPP Multi-threaded Benchmark (%d messages/thread) ===\n\n", MESSAGES_PER_THREAD);
+    std::printf("%-8s %14s %14s %14s\n", "threads", "filtered ns", "sync ns", "async ns");
+
+    for (int threadCount : threadCounts)
+    {
+        double filtered = runThreads(threadCount, LogLevel::DEBUG1);
+        double sync = runThreads(threadCount, LogLevel::INFO);
+
+        logger->startAsync();
+        double async = runThreads(threadCount, LogLevel::INFO);
+        logger->stopAsync();
+
+        std::printf("%-8d %14.1f %14.1f %14.1f\n", threadCount, filtered, sync, async);
+    }
+
+    std::printf("\nHandled %llu messages\n", static_cast<unsigned long long>(handled.load()));
+    return 0;
+}
@@ -0,0 +1,23 @@
+#include "../Includes/BinaryLogFormat.hpp"
+#include <iostream>
+
+// Convert binary log files to JSON lines on stdout
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <file.bin>...\n";
+        return 2;
+    }
+
+    int status = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (binaryLogToJsonLines(argv[i], std::cout) < 0)
+        {
+            std::cerr << argv[i] << ": unreadable or malformed binary log\n";
+            status = 1;
+        }
+    }
+    return status;
+}
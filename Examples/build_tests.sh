@@ -72,6 +72,95 @@ echo "Building: test_rotation (static linking with file rotation)"
 $COMPILER_CPP $CPPFLAGS -I"$INCLUDE_DIR" "test_rotation.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_rotation"
 echo "  ✓ Created: $BUILD_DIR/test_rotation"
 
+echo "Building: test_async (static linking with asynchronous logging)"
+$COMPILER_CPP $CPPFLAGS -pthread -I"$INCLUDE_DIR" "test_async.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_async"
+echo "  ✓ Created: $BUILD_DIR/test_async"
+
+echo "Building: test_binary (static linking with binary log format)"
+$COMPILER_CPP $CPPFLAGS -I"$INCLUDE_DIR" "test_binary.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_binary"
+echo "  ✓ Created: $BUILD_DIR/test_binary"
+
+echo "Building: binary_to_json (binary log to JSON lines converter)"
+$COMPILER_CPP $CPPFLAGS -I"$INCLUDE_DIR" "binary_to_json.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/binary_to_json"
+echo "  ✓ Created: $BUILD_DIR/binary_to_json"
+
+echo "Building: test_events (static linking with schema-defined events)"
+$COMPILER_CPP $CPPFLAGS -pthread -I"$INCLUDE_DIR" "test_events.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_events"
+echo "  ✓ Created: $BUILD_DIR/test_events"
+
+echo "Building: test_framing (static linking with checksummed blocks)"
+$COMPILER_CPP $CPPFLAGS -pthread -I"$INCLUDE_DIR" "test_framing.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_framing"
+echo "  ✓ Created: $BUILD_DIR/test_framing"
+
+echo "Building: test_compression (static linking with compressed blocks)"
+$COMPILER_CPP $CPPFLAGS -pthread -I"$INCLUDE_DIR" "test_compression.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_compression"
+echo "  ✓ Created: $BUILD_DIR/test_compression"
+
+echo "Building: test_seek_index (static linking with seekable compressed segments)"
+$COMPILER_CPP $CPPFLAGS -pthread -I"$INCLUDE_DIR" "test_seek_index.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_seek_index"
+echo "  ✓ Created: $BUILD_DIR/test_seek_index"
+
+echo "Building: test_spill (static linking with disk spill)"
+$COMPILER_CPP $CPPFLAGS -pthread -I"$INCLUDE_DIR" "test_spill.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_spill"
+echo "  ✓ Created: $BUILD_DIR/test_spill"
+
+echo "Building: test_redaction (static linking with secret redaction)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_redaction.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_redaction"
+echo "  ✓ Created: $BUILD_DIR/test_redaction"
+
+echo "Building: test_sanitize (static linking with message sanitization)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_sanitize.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_sanitize"
+echo "  ✓ Created: $BUILD_DIR/test_sanitize"
+
+echo "Building: test_emergency (static linking with simulated memory exhaustion)"
+$COMPILER_CPP $CPPFLAGS -pthread -I"$INCLUDE_DIR" "test_emergency.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_emergency"
+echo "  ✓ Created: $BUILD_DIR/test_emergency"
+
+echo "Building: test_signal_safe (static linking with async-signal-safe logging)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_signal_safe.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_signal_safe"
+echo "  ✓ Created: $BUILD_DIR/test_signal_safe"
+
+echo "Building: test_realtime (static linking, run with the allocation/syscall interception shim)"
+$COMPILER_C -O2 -shared -fPIC "realtime_intercept.c" -ldl -o "$BUILD_DIR/librealtime_intercept.so"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_realtime.cpp" "$LIB_DIR/liblog4cpp.a" -ldl -o "$BUILD_DIR/test_realtime"
+echo "  ✓ Created: $BUILD_DIR/test_realtime"
+
+echo "Building: test_spans (static linking with timing spans and Chrome trace output)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_spans.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_spans"
+echo "  ✓ Created: $BUILD_DIR/test_spans"
+
+echo "Building: test_backpressure (static linking with adaptive verbosity)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_backpressure.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_backpressure"
+echo "  ✓ Created: $BUILD_DIR/test_backpressure"
+
+echo "Building: test_disk_full (static linking with the file handler's circuit breaker)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_disk_full.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_disk_full"
+echo "  ✓ Created: $BUILD_DIR/test_disk_full"
+
+echo "Building: test_watchdog (static linking with the slow-handler watchdog)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_watchdog.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_watchdog"
+echo "  ✓ Created: $BUILD_DIR/test_watchdog"
+
+echo "Building: test_memory_ring (static linking with the in-memory ring)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_memory_ring.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_memory_ring"
+echo "  ✓ Created: $BUILD_DIR/test_memory_ring"
+
+echo "Building: test_numa (static linking with NUMA-local buffers)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_numa.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_numa"
+echo "  ✓ Created: $BUILD_DIR/test_numa"
+
+echo "Building: test_warmup (static linking with the startup warm-up)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_warmup.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_warmup"
+echo "  ✓ Created: $BUILD_DIR/test_warmup"
+
+echo "Building: test_early_setup (static linking, setup before initialize)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "test_early_setup.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/test_early_setup"
+echo "  ✓ Created: $BUILD_DIR/test_early_setup"
+
+echo "Building: bench_multithread (static linking, -O2)"
+$COMPILER_CPP $CPPFLAGS -O2 -pthread -I"$INCLUDE_DIR" "bench_multithread.cpp" "$LIB_DIR/liblog4cpp.a" -o "$BUILD_DIR/bench_multithread"
+echo "  ✓ Created: $BUILD_DIR/bench_multithread"
+
 echo ""
 echo "=== Build Complete ==="
 echo ""
@@ -85,3 +174,6 @@ echo "    export LD_LIBRARY_PATH=$LIB_DIR:\$LD_LIBRARY_PATH"
 echo "    $BUILD_DIR/test_c_dynamic"
 echo "    $BUILD_DIR/test_cpp_dynamic"
 echo ""
+echo "  Benchmark:"
+echo "    $BUILD_DIR/bench_multithread"
+echo ""
@@ -0,0 +1,163 @@
+/*
+ * LD_PRELOAD shim for test_realtime: counts calls into the allocator and
+ * into libc entry points that enter the kernel or may block, made by a
+ * thread while it has armed the shim.
+ *
+ *   LD_PRELOAD=./build/librealtime_intercept.so ./build/test_realtime
+ */
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <time.h>
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *memory, size_t size);
+extern void __libc_free(void *memory);
+extern void *__libc_memalign(size_t alignment, size_t size);
+
+static __thread int armed;
+static __thread unsigned long allocations;
+static __thread unsigned long kernelCalls;
+
+void realtime_intercept_arm(int enable)
+{
+    armed = enable;
+}
+
+unsigned long realtime_intercept_allocations(void)
+{
+    return allocations;
+}
+
+unsigned long realtime_intercept_kernel_calls(void)
+{
+    return kernelCalls;
+}
+
+#define COUNT_ALLOCATION() \
+    do                     \
+    {                      \
+        if (armed)         \
+            ++allocations; \
+    } while (0)
+
+#define COUNT_KERNEL_CALL() \
+    do                      \
+    {                       \
+        if (armed)          \
+            ++kernelCalls;  \
+    } while (0)
+
+#define NEXT(name) ((__typeof__(&name))dlsym(RTLD_NEXT, #name))
+
+/* ---- Allocator ---- */
+
+void *malloc(size_t size)
+{
+    COUNT_ALLOCATION();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    COUNT_ALLOCATION();
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *memory, size_t size)
+{
+    COUNT_ALLOCATION();
+    return __libc_realloc(memory, size);
+}
+
+void free(void *memory)
+{
+    COUNT_ALLOCATION();
+    __libc_free(memory);
+}
+
+void *memalign(size_t alignment, size_t size)
+{
+    COUNT_ALLOCATION();
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    COUNT_ALLOCATION();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **memory, size_t alignment, size_t size)
+{
+    COUNT_ALLOCATION();
+    *memory = __libc_memalign(alignment, size);
+    return *memory ? 0 : 12; /* ENOMEM */
+}
+
+/* ---- System calls and blocking primitives ---- */
+
+long syscall(long number, ...)
+{
+    va_list args;
+    long a[6];
+    int i;
+    COUNT_KERNEL_CALL();
+    va_start(args, number);
+    for (i = 0; i < 6; ++i)
+        a[i] = va_arg(args, long);
+    va_end(args);
+    return NEXT(syscall)(number, a[0], a[1], a[2], a[3], a[4], a[5]);
+}
+
+ssize_t write(int fd, const void *data, size_t size)
+{
+    COUNT_KERNEL_CALL();
+    return NEXT(write)(fd, data, size);
+}
+
+ssize_t read(int fd, void *data, size_t size)
+{
+    COUNT_KERNEL_CALL();
+    return NEXT(read)(fd, data, size);
+}
+
+int sched_yield(void)
+{
+    COUNT_KERNEL_CALL();
+    return NEXT(sched_yield)();
+}
+
+int nanosleep(const struct timespec *duration, struct timespec *remaining)
+{
+    COUNT_KERNEL_CALL();
+    return NEXT(nanosleep)(duration, remaining);
+}
+
+int pthread_mutex_lock(pthread_mutex_t *mutex)
+{
+    COUNT_KERNEL_CALL();
+    return NEXT(pthread_mutex_lock)(mutex);
+}
+
+int pthread_mutex_trylock(pthread_mutex_t *mutex)
+{
+    COUNT_KERNEL_CALL();
+    return NEXT(pthread_mutex_trylock)(mutex);
+}
+
+int pthread_cond_signal(pthread_cond_t *condition)
+{
+    COUNT_KERNEL_CALL();
+    return NEXT(pthread_cond_signal)(condition);
+}
+
+int pthread_cond_broadcast(pthread_cond_t *condition)
+{
+    COUNT_KERNEL_CALL();
+    return NEXT(pthread_cond_broadcast)(condition);
+}
@@ -48,3 +48,123 @@ echo "================================"
 ./build/test_rotation
 
 echo ""
+echo "================================"
+echo "7. Asynchronous Logging Test"
+echo "================================"
+./build/test_async
+
+echo ""
+echo "================================"
+echo "8. Binary Log Format Test"
+echo "================================"
+./build/test_binary
+
+echo ""
+echo "================================"
+echo "9. Schema-Defined Events Test"
+echo "================================"
+./build/test_events
+
+echo ""
+echo "================================"
+echo "10. Checksummed Blocks Test"
+echo "================================"
+./build/test_framing
+
+echo ""
+echo "================================"
+echo "11. Compressed Blocks Test"
+echo "================================"
+./build/test_compression
+
+echo ""
+echo "================================"
+echo "12. Seekable Segments Test"
+echo "================================"
+./build/test_seek_index
+
+echo ""
+echo "================================"
+echo "13. Disk Spill Test"
+echo "================================"
+./build/test_spill
+
+echo ""
+echo "================================"
+echo "14. Secret Redaction Test"
+echo "================================"
+./build/test_redaction
+
+echo ""
+echo "================================"
+echo "15. Message Sanitization Test"
+echo "================================"
+./build/test_sanitize
+
+echo ""
+echo "================================"
+echo "16. Emergency Logging Test"
+echo "================================"
+./build/test_emergency
+
+echo ""
+echo "================================"
+echo "17. Signal-Safe Logging Test"
+echo "================================"
+./build/test_signal_safe
+
+echo ""
+echo "================================"
+echo "18. Real-Time Logging Test"
+echo "================================"
+LD_PRELOAD=./build/librealtime_intercept.so ./build/test_realtime
+
+echo ""
+echo "================================"
+echo "19. Timing Spans Test"
+echo "================================"
+./build/test_spans
+
+echo ""
+echo "================================"
+echo "20. Adaptive Verbosity Test"
+echo "================================"
+./build/test_backpressure
+
+echo ""
+echo "================================"
+echo "21. Disk-Full Circuit Breaker Test"
+echo "================================"
+./build/test_disk_full
+
+echo ""
+echo "================================"
+echo "22. Slow-Handler Watchdog Test"
+echo "================================"
+./build/test_watchdog
+
+echo ""
+echo "================================"
+echo "23. In-Memory Ring Test"
+echo "================================"
+./build/test_memory_ring
+
+echo ""
+echo "================================"
+echo "24. NUMA-Local Buffers Test"
+echo "================================"
+./build/test_numa
+
+echo ""
+echo "================================"
+echo "25. Warm-Up Test"
+echo "================================"
+./build/test_warmup
+
+echo ""
+echo "================================"
+echo "26. Setup Before initialize() Test"
+echo "================================"
+./build/test_early_setup
+
+echo ""
@@ -0,0 +1,81 @@
+#include "../Includes/Logger.hpp"
+#include "../Includes/FileRotatingHandler.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main()
+{
+    // Clean up old test logs
+    system("rm -f test_async.log* 2>/dev/null");
+
+    Logger::initialize("AsyncTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+    logger->clearHandlers();
+    registerFileRotatingHandler("test_async.log", 10 * 1024 * 1024, 2);
+
+    std::cout << "=== Asynchronous Logging ===\n";
+    std::cout << "4 threads x 10000 messages through per-thread record slabs\n\n";
+
+    // Small slabs, prefaulted at startup
+    AsyncLogOptions options;
+    options.slabSize = 256 * 1024;
+    options.prefault = true;
+    logger->startAsync(options);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back([t]
+                             {
+            for (int i = 0; i < 10000; ++i)
+            {
+                LOG_CPP_INFO("Worker ", t, " message ", i);
+            } });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    // Wait for the backend thread to write everything queued so far
+    logger->flush();
+
+    std::cout << "=== Log File ===\n"
+              << std::flush;
+    system("echo '--- test_async.log (first 3 lines) ---' && head -3 test_async.log && echo '...'");
+
+    logger->stopAsync();
+
+    // Every message exactly once, in order within each worker
+    std::ifstream in("test_async.log");
+    std::string line;
+    size_t lines = 0;
+    size_t outOfOrder = 0;
+    std::vector<int> next(4, 0);
+    while (std::getline(in, line))
+    {
+        ++lines;
+        size_t found = line.find("Worker ");
+        int worker = -1;
+        int message = -1;
+        std::string word;
+        if (found != std::string::npos)
+        {
+            std::istringstream fields(line.substr(found));
+            fields >> word >> worker >> word >> message;
+        }
+        if (worker < 0 || worker >= 4 || message != next[worker])
+        {
+            ++outOfOrder;
+            continue;
+        }
+        ++next[worker];
+    }
+    bool complete = next[0] == 10000 && next[1] == 10000 && next[2] == 10000 && next[3] == 10000;
+    std::cout << "Lines written: " << lines << " (expected 40000), out of order or unknown: " << outOfOrder << "\n";
+    return lines == 40000 && outOfOrder == 0 && complete ? 0 : 1;
+}
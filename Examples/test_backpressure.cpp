@@ -0,0 +1,156 @@
+#include "../Includes/Logger.hpp"
+#include "TestCheck.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Written
+{
+    LogLevel level;
+    std::string message;
+};
+
+static std::mutex writtenMutex;
+static std::vector<Written> written;
+static std::atomic<int> handlerDelayUs(0);
+
+// A handler as slow as a struggling disk
+static void slowHandler(const LogEntry &entry)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(handlerDelayUs.load()));
+    std::lock_guard<std::mutex> lock(writtenMutex);
+    written.push_back({entry.severity, entry.message});
+}
+
+static bool isNotice(const Written &entry)
+{
+    return entry.message.compare(0, 15, "Logging backend") == 0;
+}
+
+static size_t countNotices()
+{
+    std::lock_guard<std::mutex> lock(writtenMutex);
+    size_t notices = 0;
+    for (const Written &entry : written)
+    {
+        notices += isNotice(entry);
+    }
+    return notices;
+}
+
+int main()
+{
+    std::cout << "=== Adaptive Verbosity ===\n";
+
+    Logger::initialize("BackpressureTest", LogLevel::DEBUG1);
+    Logger *logger = Logger::getInstance();
+    logger->setHandler(&slowHandler);
+
+    bool ok = true;
+
+    // Queue depth: a burst into a small slab behind a slow handler
+    AsyncLogOptions options;
+    options.slabSize = 64 * 1024;
+    options.pressureLevel = LogLevel::INFO;
+    handlerDelayUs = 50;
+    logger->startAsync(options);
+
+    const int burst = 4000;
+    for (int i = 0; i < burst; ++i)
+    {
+        if (i % 10 == 0)
+        {
+            LOG_CPP_INFO("request ", i);
+        }
+        else
+        {
+            LOG_CPP_DEBUG1("detail ", i);
+        }
+    }
+    LogLevel duringBurst = logger->getEffectiveLogLevel();
+    logger->flush();
+    logger->flush(); // One more drain that finds the slab empty
+
+    size_t infos = 0;
+    size_t debugs = 0;
+    std::vector<Written> notices;
+    {
+        std::lock_guard<std::mutex> lock(writtenMutex);
+        for (const Written &entry : written)
+        {
+            if (isNotice(entry))
+            {
+                notices.push_back(entry);
+            }
+            else
+            {
+                infos += entry.level == LogLevel::INFO;
+                debugs += entry.level == LogLevel::DEBUG1;
+            }
+        }
+    }
+    for (const Written &notice : notices)
+    {
+        std::cout << "  " << logLevelInfo(notice.level).name << " " << notice.message << "\n";
+    }
+    std::cout << "Burst: " << infos << " INFO and " << debugs << " of " << burst - burst / 10 << " DEBUG1 written\n";
+    ok &= check("threshold raised while the backend falls behind",
+                duringBurst == LogLevel::INFO && logger->getLogLevel() == LogLevel::DEBUG1);
+    ok &= check("suppressed entries filtered, the rest all written",
+                infos == static_cast<size_t>(burst / 10) && debugs < static_cast<size_t>(burst - burst / 10));
+    ok &= check("one notice when raised, one when restored",
+                notices.size() == 2 && notices[0].level == LogLevel::WARN &&
+                    notices[0].message.find("entries below INFO suppressed") != std::string::npos &&
+                    notices[1].level == LogLevel::INFO &&
+                    notices[1].message == "Logging backend caught up: level restored to DEBUG1");
+    ok &= check("threshold restored once the backlog cleared", logger->getEffectiveLogLevel() == LogLevel::DEBUG1);
+    logger->stopAsync();
+
+    // Write latency: a slow handler raises the threshold even with slabs nearly empty
+    {
+        std::lock_guard<std::mutex> lock(writtenMutex);
+        written.clear();
+    }
+    options.slabSize = 1024 * 1024;
+    options.pressureHighWatermark = 1.0;
+    options.pressureLatencyUs = 5000;
+    handlerDelayUs = 10000;
+    logger->startAsync(options);
+    LOG_CPP_INFO("slow write");
+    logger->flush();
+    LogLevel afterSlowDrain = logger->getEffectiveLogLevel();
+    LOG_CPP_DEBUG1("suppressed");
+    handlerDelayUs = 0;
+    LOG_CPP_INFO("fast write");
+    logger->flush();
+    logger->flush();
+    ok &= check("slow writes raise the threshold", afterSlowDrain == LogLevel::INFO);
+    ok &= check("fast writes restore it",
+                logger->getEffectiveLogLevel() == LogLevel::DEBUG1 && countNotices() == 2);
+    {
+        std::lock_guard<std::mutex> lock(writtenMutex);
+        bool suppressed = false;
+        for (const Written &entry : written)
+        {
+            suppressed = suppressed || entry.message == "suppressed";
+        }
+        ok &= check("entry below the raised threshold not written", !suppressed);
+    }
+
+    // setLogLevel() under pressure keeps the raised threshold; stopAsync() restores
+    handlerDelayUs = 10000;
+    LOG_CPP_INFO("slow again");
+    logger->flush();
+    logger->setLogLevel(LogLevel::DEBUG2);
+    LogLevel afterSetLevel = logger->getEffectiveLogLevel();
+    logger->stopAsync();
+    ok &= check("level changes while raised take effect afterwards",
+                afterSetLevel == LogLevel::INFO && logger->getLogLevel() == LogLevel::DEBUG2 &&
+                    logger->getEffectiveLogLevel() == LogLevel::DEBUG2 && countNotices() == 4);
+
+    return ok ? 0 : 1;
+}
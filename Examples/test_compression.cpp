@@ -0,0 +1,117 @@
+#include "../Includes/Logger.hpp"
+#include "../Includes/FileRotatingHandler.hpp"
+#include "../Includes/BinaryLogFormat.hpp"
+#include "../Includes/LogFraming.hpp"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+
+static std::string readFile(const std::string &path)
+{
+    std::ifstream input(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+}
+
+// Compress payload into a frame and read it back
+static bool roundTrip(const std::string &payload)
+{
+    std::string frame;
+    appendCompressedLogFrame(payload.data(), payload.size(), frame);
+    std::string decoded;
+    LogFrameScan scan = scanLogFrames(frame.data(), frame.size(), [&decoded](const char *data, size_t size)
+                                      { decoded.append(data, size); });
+    return scan.blocks == 1 && scan.skippedBytes == 0 && decoded == payload;
+}
+
+int main()
+{
+    // Clean up old test logs
+    system("rm -f test_compressed.log* test_compressed.bin* 2>/dev/null");
+
+    std::cout << "=== Compressed Blocks ===\n";
+
+    std::mt19937 random(42);
+    std::string noise(100000, '\0');
+    for (char &c : noise)
+    {
+        c = static_cast<char>(random());
+    }
+    std::string repeated;
+    for (int i = 0; i < 5000; ++i)
+    {
+        repeated += "[INFO ][component] request " + std::to_string(i % 97) + " done\n";
+    }
+    bool codecOk = roundTrip("") && roundTrip("short") && roundTrip(std::string(70000, 'a')) &&
+                   roundTrip(repeated) && roundTrip(noise) && roundTrip(repeated + noise + repeated);
+    std::cout << "Codec round trips: " << (codecOk ? "ok" : "FAILED") << "\n";
+
+    Logger::initialize("CompressionTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+    logger->clearHandlers();
+
+    const size_t maxFileSize = 64 * 1024;
+    const int backups = 50;
+
+    FileRotatingHandler::Options textOptions;
+    textOptions.compress = true;
+    registerFileRotatingHandler("test_compressed.log", maxFileSize, backups, textOptions);
+
+    FileRotatingHandler::Options binaryOptions;
+    binaryOptions.encoder = std::make_shared<BinaryLogEncoder>();
+    binaryOptions.compress = true;
+    registerFileRotatingHandler("test_compressed.bin", 10 * 1024 * 1024, 2, binaryOptions);
+
+    // Asynchronous mode: each backend drain cycle becomes one compressed block
+    logger->startAsync();
+    for (int i = 0; i < 50000; ++i)
+    {
+        LOG_CPP_INFO("Compressed message ", i, " status=ok");
+    }
+    logger->stopAsync();
+
+    // Walk the rotated files: every file within maxFileSize, no line lost
+    size_t lines = 0;
+    size_t compressedBytes = 0;
+    size_t rawBytes = 0;
+    size_t skippedBytes = 0;
+    bool withinLimit = true;
+    int files = 0;
+    for (int i = backups; i >= 0; --i)
+    {
+        std::string path = i == 0 ? "test_compressed.log" : "test_compressed.log." + std::to_string(i);
+        std::ifstream probe(path);
+        if (!probe)
+        {
+            continue;
+        }
+        std::string data = readFile(path);
+        ++files;
+        compressedBytes += data.size();
+        withinLimit = withinLimit && data.size() <= maxFileSize;
+        LogFrameScan scan = scanLogFrames(data.data(), data.size(), [&](const char *payload, size_t size)
+                                          {
+            rawBytes += size;
+            for (size_t j = 0; j < size; ++j)
+            {
+                lines += payload[j] == '\n';
+            } });
+        skippedBytes += scan.skippedBytes;
+    }
+    std::cout << "Text files:   " << files << " files, " << lines << " lines, " << compressedBytes
+              << " bytes compressed from " << rawBytes << " (" << (rawBytes / (compressedBytes ? compressedBytes : 1))
+              << "x), " << skippedBytes << " bytes skipped\n";
+    std::cout << "Size limit:   " << (withinLimit ? "every file within maxFileSize" : "EXCEEDED") << "\n";
+
+    std::ostringstream json;
+    long entries = binaryLogToJsonLines("test_compressed.bin", json);
+    std::cout << "Binary file:  " << entries << " entries decoded (expected 50000)\n";
+
+    return codecOk && lines == 50000 && skippedBytes == 0 && withinLimit && compressedBytes < rawBytes &&
+                   entries == 50000
+               ? 0
+               : 1;
+}
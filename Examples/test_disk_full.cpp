@@ -0,0 +1,151 @@
+#include "../Includes/Logger.hpp"
+#include "../Includes/FileRotatingHandler.hpp"
+#include "TestCheck.hpp"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+
+static std::string readFile(const char *path)
+{
+    std::ifstream in(path);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+static bool fileExists(const char *path)
+{
+    return access(path, F_OK) == 0;
+}
+
+static size_t countLines(const std::string &text)
+{
+    size_t lines = 0;
+    for (char c : text)
+    {
+        lines += c == '\n';
+    }
+    return lines;
+}
+
+// Simulates a full disk: writes past `bytes` fail with EFBIG, like ENOSPC.
+// The limit applies to every file, stdout included, so nothing is printed
+// while it is set.
+static void limitFileSize(rlim_t bytes)
+{
+    struct rlimit limit;
+    getrlimit(RLIMIT_FSIZE, &limit);
+    limit.rlim_cur = bytes;
+    setrlimit(RLIMIT_FSIZE, &limit);
+}
+
+int main()
+{
+    system("rm -f test_disk_full.log* test_disk_full_stderr.txt 2>/dev/null");
+    std::cout << "=== Disk-Full Circuit Breaker ===\n";
+    signal(SIGXFSZ, SIG_IGN); // Let the write fail instead of killing the process
+
+    Logger::initialize("DiskFullTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+    logger->clearHandlers();
+
+    FileRotatingHandler::Options options;
+    options.probeIntervalMs = 300;
+    options.minFreeBytes = 0;
+    registerFileRotatingHandler("test_disk_full.log", 1024 * 1024, 3, options);
+
+    // Error reports go to stderr: capture them
+    fflush(stderr);
+    int savedStderr = dup(STDERR_FILENO);
+    FILE *captured = std::freopen("test_disk_full_stderr.txt", "w", stderr);
+    (void)captured;
+    std::cerr << std::unitbuf;
+
+    bool ok = true;
+
+    // The disk fills up part way through, and stays full past the first probe
+    std::cout << std::flush;
+    limitFileSize(4096);
+    const int entries = 200;
+    for (int i = 0; i < entries; ++i)
+    {
+        LOG_CPP_INFO("entry ", i, " of the burst");
+    }
+    limitFileSize(RLIM_INFINITY);
+    std::string file = readFile("test_disk_full.log");
+    size_t writtenLines = countLines(file);
+    std::cout << "Burst: " << writtenLines << " of " << entries << " entries written, file " << file.size()
+              << " bytes\n";
+    ok &= check("writes stop at the failure", writtenLines > 0 && writtenLines < static_cast<size_t>(entries));
+    ok &= check("no torn line left behind", !file.empty() && file.back() == '\n');
+
+    // Discarding is cheap
+    const int discards = 100000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < discards; ++i)
+    {
+        LOG_CPP_INFO("discarded ", i);
+    }
+    double discardNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / discards;
+    std::cout << "Discarded entry: " << discardNs << " ns\n";
+    ok &= check("nothing written while suspended", readFile("test_disk_full.log") == file);
+
+    // The next probe finds space and resumes writing
+    std::this_thread::sleep_for(std::chrono::milliseconds(350));
+    LOG_CPP_INFO("after the disk recovered");
+    file = readFile("test_disk_full.log");
+    ok &= check("writing resumes after a probe",
+                countLines(file) == writtenLines + 1 &&
+                    file.find("after the disk recovered") != std::string::npos);
+
+    // Emergency deletion of backups while space stays short
+    logger->clearHandlers();
+    for (const char *backup : {"test_disk_full_b.log.1", "test_disk_full_b.log.2", "test_disk_full_b.log.3"})
+    {
+        std::ofstream(backup) << "old entries\n";
+    }
+    options.minFreeBytes = UINT64_MAX;
+    options.deleteBackupsWhenFull = true;
+    registerFileRotatingHandler("test_disk_full_b.log", 1024 * 1024, 3, options);
+    std::cout << std::flush;
+    limitFileSize(1024);
+    for (int i = 0; i < 50; ++i)
+    {
+        LOG_CPP_INFO("entry ", i, " of the second burst");
+    }
+    limitFileSize(RLIM_INFINITY);
+    std::this_thread::sleep_for(std::chrono::milliseconds(350));
+    LOG_CPP_INFO("still short of space");
+    logger->clearHandlers();
+
+    fflush(stderr);
+    dup2(savedStderr, STDERR_FILENO);
+    close(savedStderr);
+
+    std::string errors = readFile("test_disk_full_stderr.txt");
+    std::cout << "Stderr:\n" << errors;
+    std::string resumed = "Log file writable again: test_disk_full.log (" +
+                          std::to_string(entries - writtenLines + discards) + " entries discarded)";
+    ok &= check("failure and recovery reported once each",
+                errors.find("Error writing log file: test_disk_full.log (File too large)") != std::string::npos &&
+                    errors.find(resumed) != std::string::npos);
+    ok &= check("oldest backups deleted first",
+                !fileExists("test_disk_full_b.log.1") && !fileExists("test_disk_full_b.log.2") &&
+                    !fileExists("test_disk_full_b.log.3") &&
+                    errors.find("test_disk_full_b.log.3") < errors.find("test_disk_full_b.log.2") &&
+                    errors.find("test_disk_full_b.log.2") < errors.find("test_disk_full_b.log.1"));
+    ok &= check("stays suspended while space is short",
+                fileExists("test_disk_full_b.log") &&
+                    readFile("test_disk_full_b.log").find("still short of space") == std::string::npos);
+
+    system("rm -f test_disk_full.log* test_disk_full_b.log* test_disk_full_stderr.txt 2>/dev/null");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+#include "../Includes/Logger.hpp"
+#include "../Includes/LogMemoryResource.hpp"
+#include "TestCheck.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct SeenEntry
+{
+    std::string component;
+    std::string threadName;
+    std::string message;
+};
+
+static std::vector<SeenEntry> seen;
+
+// Counts what the logger takes from it
+class CountingResource : public LogMemoryResource
+{
+public:
+    size_t allocations = 0;
+
+protected:
+    void *doAllocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        return defaultLogMemoryResource()->allocate(bytes, alignment);
+    }
+
+    void doDeallocate(void *memory, size_t bytes, size_t alignment) override
+    {
+        defaultLogMemoryResource()->deallocate(memory, bytes, alignment);
+    }
+};
+
+int main()
+{
+    std::cout << "=== Setup Before initialize() ===\n";
+
+    // Per-thread settings made before the logger exists must not create
+    // the default one
+    Logger::setThreadName("main");
+    CountingResource resource;
+    Logger::setThreadMemoryResource(&resource);
+
+    Logger::initialize("EarlyTest", LogLevel::DEBUG1);
+    Logger *logger = Logger::getInstance();
+    logger->setHandler([](const LogEntry &entry)
+                       { seen.push_back({entry.component, entry.threadName, entry.message}); });
+
+    LOG_CPP_DEBUG1("debug line");
+    LOG_CPP_INFO("info line");
+    LOG_CPP_INFO(std::string(1000, 'x')); // Outgrows the stream's inline storage
+    Logger::setThreadMemoryResource(nullptr);
+
+    bool ok = true;
+    for (const SeenEntry &entry : seen)
+    {
+        std::cout << "  [" << entry.component << "][" << entry.threadName << "] " << entry.message.substr(0, 40) << "\n";
+    }
+    ok &= check("initialize() settings kept", seen.size() == 3 && seen[0].component == "EarlyTest" &&
+                                                  seen[0].message == "debug line");
+    ok &= check("thread name picked up at the first log call", !seen.empty() && seen[0].threadName == "main");
+    ok &= check("thread memory resource used", resource.allocations > 0);
+
+    return ok ? 0 : 1;
+}
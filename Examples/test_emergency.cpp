@@ -0,0 +1,112 @@
+#include "../Includes/Logger.hpp"
+#include "../Includes/FileRotatingHandler.hpp"
+#include "TestCheck.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+// Simulated memory exhaustion: while set, every operator new throws
+static std::atomic<bool> outOfMemory(false);
+
+void *operator new(size_t size)
+{
+    if (outOfMemory.load(std::memory_order_relaxed))
+    {
+        throw std::bad_alloc();
+    }
+    void *memory = std::malloc(size != 0 ? size : 1);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+static std::string readFile(const char *path)
+{
+    std::ifstream in(path);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+int main()
+{
+    system("rm -f test_emergency.log test_emergency_stderr.txt 2>/dev/null");
+    std::cout << "=== Emergency Logging Under Memory Exhaustion ===\n" << std::flush;
+
+    Logger::initialize("OomTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+    logger->clearHandlers();
+
+    // A file whose formatter allocates, and a handler with no fallback
+    registerFileRotatingHandler("test_emergency.log", 1024 * 1024, 1, [](const LogEntry &entry)
+                                { return std::string("custom ") + entry.message.data(); });
+    logger->registerHandler([](const LogEntry &entry)
+                            { std::string copy(entry.message.data(), entry.message.size()); });
+
+    // The fallback for the second handler is stderr: capture it
+    fflush(stderr);
+    int savedStderr = dup(STDERR_FILENO);
+    FILE *captured = std::freopen("test_emergency_stderr.txt", "w", stderr);
+    (void)captured;
+
+    LOG_CPP_INFO("warm-up before the failure");
+
+    std::string big(5000, 'x');
+    outOfMemory = true;
+    LOG_CPP_ERROR("allocation failed in cache refill, size=", 4096, " ", big.c_str());
+    LOG_CPP_ERROR("injected\nline");
+    outOfMemory = false;
+
+    // Asynchronous: a new thread cannot get its slab, so it writes directly
+    logger->startAsync();
+    std::thread worker([]()
+                       {
+        outOfMemory = true;
+        LOG_CPP_ERROR("from a thread that could not get a slab");
+        outOfMemory = false; });
+    worker.join();
+    logger->stopAsync();
+
+    fflush(stderr);
+    dup2(savedStderr, STDERR_FILENO);
+    close(savedStderr);
+
+    std::string file = readFile("test_emergency.log");
+    std::string errors = readFile("test_emergency_stderr.txt");
+    std::cout << "File:\n" << file.substr(0, 200) << "...\n";
+
+    bool ok = true;
+    ok &= check("normal entry written by the formatter", file.find("custom warm-up before the failure") != std::string::npos);
+    ok &= check("failed entry written from the emergency line",
+                file.find("[ERROR ][OomTest][main:") != std::string::npos &&
+                    file.find("allocation failed in cache refill, size=4096 xxxx") != std::string::npos);
+    ok &= check("oversized message cut with \"...\"", file.find("xxx...\n") != std::string::npos);
+    ok &= check("line break kept out of the emergency line", file.find("injected?line") != std::string::npos);
+    ok &= check("handler without a fallback reported on stderr",
+                errors.find("allocation failed in cache refill") != std::string::npos);
+    ok &= check("thread without a slab still logged",
+                file.find("from a thread that could not get a slab") != std::string::npos &&
+                    errors.find("from a thread that could not get a slab") != std::string::npos);
+
+    system("rm -f test_emergency_stderr.txt 2>/dev/null");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+#include "../Includes/Logger.hpp"
+#include "../Includes/LogEvent.hpp"
+#include "../Includes/FileRotatingHandler.hpp"
+#include "../Includes/BinaryLogFormat.hpp"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+enum class Side : uint8_t
+{
+    BUY,
+    SELL
+};
+
+// Fixed-shape events: logging one is a copy of the struct
+LOG4CPP_EVENT(Fill, (uint64_t, orderId), (double, px), (uint32_t, qty));
+LOG4CPP_EVENT(Quote, (char[8], symbol), (Side, side), (double, bid), (double, ask), (bool, firm));
+
+int main()
+{
+    // Clean up old test logs
+    system("rm -f test_events.bin* 2>/dev/null");
+
+    Logger::initialize("EventTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+
+    std::cout << "=== Schema-Defined Events ===\n";
+    std::cout << "sizeof(Fill) = " << sizeof(Fill) << ", sizeof(Quote) = " << sizeof(Quote) << "\n\n"
+              << std::flush;
+
+    Quote quote{};
+    std::strncpy(quote.symbol, "ACME", sizeof(quote.symbol) - 1);
+    quote.side = Side::SELL;
+    quote.bid = 99.75;
+    quote.ask = 100.25;
+    quote.firm = true;
+
+    // Synchronous: rendered on the calling thread
+    LOG_CPP_EVENT(INFO, Fill{42, 101.5, 100});
+    LOG_CPP_EVENT(WARN, quote);
+
+    // Asynchronous: raw bytes through the slab, rendered by the backend
+    logger->clearHandlers();
+    registerFileRotatingHandler("test_events.bin", 10 * 1024 * 1024, 2, std::make_shared<BinaryLogEncoder>());
+    logger->startAsync();
+    for (uint64_t i = 0; i < 10000; ++i)
+    {
+        LOG_CPP_EVENT(INFO, Fill{i, 100.0 + static_cast<double>(i % 50) / 4, static_cast<uint32_t>(i % 7 + 1)});
+    }
+    LOG_CPP_EVENT(WARN, quote);
+    logger->stopAsync();
+
+    // Events keep their typed fields in the binary log
+    std::ostringstream json;
+    long count = binaryLogToJsonLines("test_events.bin", json);
+    std::string lines = json.str();
+    size_t lastLine = lines.rfind('\n', lines.size() - 2) + 1;
+    std::cout << "\n=== Binary Log (JSON lines) ===\n";
+    std::cout << lines.substr(0, lines.find('\n') + 1) << "...\n"
+              << lines.substr(lastLine);
+    std::cout << "Events decoded: " << count << " (expected 10001)\n";
+    return count == 10001 ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+#include "../Includes/Logger.hpp"
+#include "../Includes/MemoryRingHandler.hpp"
+#include "TestCheck.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void handleLogin(int user)
+{
+    LOG_CPP_INFO("login user=", user);
+}
+
+int main()
+{
+    std::cout << "=== In-Memory Ring ===\n";
+
+    Logger::initialize("RingTest", LogLevel::DEBUG1);
+    Logger *logger = Logger::getInstance();
+    logger->clearHandlers();
+    MemoryRingHandler *recent = registerMemoryRingHandler(100, 32);
+
+    bool ok = true;
+
+    // 250 entries into a ring of 100: only the newest are kept
+    int64_t middleNs = 0;
+    for (int i = 0; i < 250; ++i)
+    {
+        if (i == 200)
+        {
+            middleNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+        }
+        if (i % 10 == 0)
+        {
+            LOG_CPP_WARN("disk latency ", i, "ms");
+        }
+        else if (i % 5 == 0)
+        {
+            handleLogin(i);
+        }
+        else
+        {
+            LOG_CPP_DEBUG1("step ", i);
+        }
+    }
+    std::vector<LogRingRecord> all = recent->query();
+    ok &= check("ring keeps the newest records, oldest first",
+                all.size() == 100 && all.front().message == "disk latency 150ms" && all.back().message == "step 249" &&
+                    recent->getTotalEntries() == 250);
+
+    LogRingQuery warnings;
+    warnings.minLevel = LogLevel::WARN;
+    warnings.limit = 3;
+    std::vector<LogRingRecord> lastWarnings = recent->query(warnings);
+    ok &= check("last N at WARN and above",
+                lastWarnings.size() == 3 && lastWarnings[0].message == "disk latency 220ms" &&
+                    lastWarnings[2].message == "disk latency 240ms" && lastWarnings[2].level == LogLevel::WARN);
+
+    LogRingQuery sinceMiddle;
+    sinceMiddle.fromNs = middleNs;
+    std::vector<LogRingRecord> recentOnes = recent->query(sinceMiddle);
+    ok &= check("time range", recentOnes.size() == 50 && recentOnes.front().message == "disk latency 200ms");
+
+    LogRingQuery bySite;
+    bySite.site = "handleLogin";
+    bySite.contains = "user=2";
+    std::vector<LogRingRecord> logins = recent->query(bySite);
+    ok &= check("call site and substring",
+                logins.size() == 5 && logins[0].message == "login user=205" && logins[0].function == "handleLogin" &&
+                    logins[0].file == "test_memory_ring.cpp" && logins[0].lineNumber > 0);
+
+    LOG_CPP_INFO(std::string(100, 'x'));
+    LogRingRecord longest = recent->query().back();
+    ok &= check("long messages cut to maxMessageSize", longest.message.size() == 32 && longest.truncated);
+
+    // Queries while another thread keeps logging: never a torn record
+    std::atomic<bool> stop(false);
+    std::thread writer([&stop]()
+                       {
+        for (int i = 0; !stop.load(); ++i)
+        {
+            LOG_CPP_INFO(i, " ", i);
+        } });
+    size_t queries = 0;
+    size_t records = 0;
+    bool consistent = true;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        for (const LogRingRecord &record : recent->query())
+        {
+            // The writer's entries read "<i> <i>"; older ones may still be in the ring
+            size_t space = record.message.find(' ');
+            if (!record.message.empty() && record.message[0] >= '0' && record.message[0] <= '9' &&
+                (space == std::string::npos || record.message.substr(0, space) != record.message.substr(space + 1)))
+            {
+                std::cout << "  torn record: " << record.message << "\n";
+                consistent = false;
+            }
+            ++records;
+        }
+        ++queries;
+    }
+    stop = true;
+    writer.join();
+    std::cout << queries << " queries returned " << records << " records while logging\n";
+    ok &= check("concurrent queries see only whole records", consistent && queries > 0);
+
+    return ok ? 0 : 1;
+}
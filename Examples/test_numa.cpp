@@ -0,0 +1,120 @@
+#include "../Includes/Logger.hpp"
+#include "TestCheck.hpp"
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::map<uint64_t, std::vector<int>> received; // Sequence numbers per thread
+
+static size_t countEntries(const char *path, const std::string &prefix)
+{
+    size_t count = 0;
+    DIR *dir = opendir(path);
+    if (!dir)
+    {
+        return 0;
+    }
+    while (dirent *entry = readdir(dir))
+    {
+        count += std::string(entry->d_name).compare(0, prefix.size(), prefix) == 0;
+    }
+    closedir(dir);
+    return count;
+}
+
+// Nodes with CPUs, as the library sees them; at least one
+static size_t countNodes()
+{
+    size_t nodes = 0;
+    for (int id = 0; id < 1024; ++id)
+    {
+        std::ifstream in("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist");
+        std::string cpus;
+        if (in && std::getline(in, cpus) && !cpus.empty())
+        {
+            ++nodes;
+        }
+    }
+    return nodes > 1 ? nodes : 1;
+}
+
+// Log from `threads` threads; true if every entry arrived, in order per thread
+static bool logFromThreads(int threads, int perThread)
+{
+    received.clear();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([perThread]()
+                             {
+            for (int i = 0; i < perThread; ++i)
+            {
+                LOG_CPP_INFO(i);
+            } });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    Logger::getInstance()->flush();
+
+    bool inOrder = received.size() == static_cast<size_t>(threads);
+    for (const auto &thread : received)
+    {
+        inOrder = inOrder && thread.second.size() == static_cast<size_t>(perThread);
+        for (size_t i = 0; inOrder && i < thread.second.size(); ++i)
+        {
+            inOrder = thread.second[i] == static_cast<int>(i);
+        }
+    }
+    return inOrder;
+}
+
+int main()
+{
+    std::cout << "=== NUMA-Local Buffers ===\n";
+
+    Logger::initialize("NumaTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+    logger->setHandler([](const LogEntry &entry)
+                       { received[entry.threadId].push_back(std::atoi(std::string(entry.message.data(), entry.message.size()).c_str())); });
+
+    size_t nodes = countNodes();
+    std::cout << "Nodes with CPUs: " << nodes << "\n";
+
+    bool ok = true;
+
+    // One backend per node, or a single one without a NUMA topology
+    size_t threadsBefore = countEntries("/proc/self/task", "");
+    AsyncLogOptions options;
+    options.numaLocal = true;
+    options.backendPerNode = true;
+    options.slabSize = 64 * 1024;
+    logger->startAsync(options);
+    size_t backendThreads = countEntries("/proc/self/task", "") - threadsBefore;
+    std::cout << "Backend threads: " << backendThreads << "\n";
+    ok &= check("one backend thread per node", backendThreads == nodes);
+    ok &= check("entries from 4 threads all written, in order per thread", logFromThreads(4, 5000));
+    logger->stopAsync();
+
+    // Restarting builds the backends again
+    logger->startAsync(options);
+    ok &= check("restart after stopAsync", logFromThreads(2, 1000));
+    logger->stopAsync();
+
+    // Node-local slabs with a single backend
+    options.backendPerNode = false;
+    options.prefault = true;
+    logger->startAsync(options);
+    ok &= check("node-local slabs drained by a single backend", logFromThreads(3, 2000));
+    logger->stopAsync();
+
+    ok &= check("nothing left behind after stopAsync", logFromThreads(1, 10));
+
+    return ok ? 0 : 1;
+}
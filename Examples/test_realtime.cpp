@@ -0,0 +1,156 @@
+#include "../Includes/Logger.hpp"
+#include "../Includes/LogRealtime.hpp"
+#include "TestCheck.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Counters of the LD_PRELOAD shim (realtime_intercept.c), looked up at run time
+struct Intercept
+{
+    void (*arm)(int);
+    unsigned long (*allocations)();
+    unsigned long (*kernelCalls)();
+};
+
+static bool loadIntercept(Intercept &intercept)
+{
+    intercept.arm = reinterpret_cast<void (*)(int)>(dlsym(RTLD_DEFAULT, "realtime_intercept_arm"));
+    intercept.allocations = reinterpret_cast<unsigned long (*)()>(dlsym(RTLD_DEFAULT, "realtime_intercept_allocations"));
+    intercept.kernelCalls = reinterpret_cast<unsigned long (*)()>(dlsym(RTLD_DEFAULT, "realtime_intercept_kernel_calls"));
+    return intercept.arm && intercept.allocations && intercept.kernelCalls;
+}
+
+int main()
+{
+    std::cout << "=== Real-Time Logging ===\n";
+
+    Intercept intercept;
+    if (!loadIntercept(intercept))
+    {
+        std::cout << "  FAIL run with LD_PRELOAD=./build/librealtime_intercept.so\n";
+        return 1;
+    }
+
+    Logger::initialize("RealtimeTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+    std::vector<std::string> messages;
+    logger->setHandler([&messages](const LogEntry &entry)
+                       { messages.push_back(entry.message); });
+
+    bool ok = true;
+
+    // The shim itself: an allocation and a lock are seen
+    {
+        std::mutex mutex;
+        intercept.arm(1);
+        void *volatile memory = std::malloc(16); // volatile: keep the pair from being optimized out
+        mutex.lock();
+        mutex.unlock();
+        intercept.arm(0);
+        std::free(memory);
+        ok &= check("shim counts allocations and kernel entry points",
+                    intercept.allocations() > 0 && intercept.kernelCalls() > 0);
+    }
+
+    AsyncLogOptions options;
+    options.prefault = true;
+    logger->startAsync(options);
+
+    // Same text as the stream macros
+    LOG_CPP_INFO("tick ", 7, " jitter=", 1.25, " ok=", true, " axis=", 'x', " name=", std::string("pump"), " ",
+                 static_cast<unsigned char>('A'), " ", -42);
+
+    const int iterations = 10000;
+    unsigned long allocations = 0;
+    unsigned long kernelCalls = 0;
+    double worstNs = 0;
+    std::thread control([&]()
+                        {
+        logger->prepareRealtimeThread();
+        std::string name = "pump";
+        unsigned long allocationsBefore = intercept.allocations();
+        unsigned long kernelCallsBefore = intercept.kernelCalls();
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            intercept.arm(1);
+            if (i == 0)
+            {
+                LOG_CPP_REALTIME(INFO, "tick ", 7, " jitter=", 1.25, " ok=", true, " axis=", 'x', " name=", name, " ",
+                                 static_cast<unsigned char>('A'), " ", -42);
+            }
+            else
+            {
+                LOG_CPP_REALTIME(DEBUG1, "filtered ", i);
+                LOG_CPP_REALTIME(INFO, "cycle ", i, " load=", 0.5 * i);
+            }
+            intercept.arm(0);
+            double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            worstNs = std::max(worstNs, elapsed);
+            if (i % 100 == 0)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(200)); // Let the backend keep up
+            }
+        }
+        allocations = intercept.allocations() - allocationsBefore;
+        kernelCalls = intercept.kernelCalls() - kernelCallsBefore; });
+    control.join();
+    logger->flush();
+
+    uint64_t dropped = logger->getDroppedRealtimeEntries();
+    std::cout << "Real-time thread: " << iterations << " entries, " << allocations << " allocations, " << kernelCalls
+              << " kernel entry points, " << dropped << " dropped, worst call " << worstNs << " ns\n";
+    ok &= check("no allocation on the producer path", allocations == 0);
+    ok &= check("no system call or lock on the producer path", kernelCalls == 0);
+    ok &= check("formatted on the backend like the stream macros",
+                messages.size() >= 2 && messages[0] == messages[1] &&
+                    messages[1] == "tick 7 jitter=1.25 ok=1 axis=x name=pump A -42");
+    ok &= check("every entry written or counted as dropped", messages.size() - 1 + dropped == iterations);
+    bool ordered = true;
+    int last = 0;
+    for (size_t i = 2; i < messages.size(); ++i)
+    {
+        int cycle = std::atoi(messages[i].c_str() + 6);
+        ordered = ordered && cycle > last;
+        last = cycle;
+    }
+    ok &= check("entries in order", ordered);
+
+    // A full slab drops instead of waiting
+    logger->stopAsync();
+    options.slabSize = 4096;
+    logger->startAsync(options);
+    messages.clear();
+    uint64_t droppedBefore = logger->getDroppedRealtimeEntries();
+    std::thread burst([&]()
+                      {
+        logger->prepareRealtimeThread();
+        for (int i = 0; i < 5000; ++i)
+        {
+            LOG_CPP_REALTIME(INFO, "burst ", i);
+        } });
+    burst.join();
+    logger->flush();
+    uint64_t burstDropped = logger->getDroppedRealtimeEntries() - droppedBefore;
+    std::cout << "Burst into a 4 KB slab: " << messages.size() << " written, " << burstDropped << " dropped\n";
+    ok &= check("full slab: entries dropped and counted", burstDropped > 0 && messages.size() + burstDropped == 5000);
+
+    // Unprepared thread and synchronous mode: dropped, never written from the caller
+    droppedBefore = logger->getDroppedRealtimeEntries();
+    std::thread unprepared([]()
+                           { LOG_CPP_REALTIME(INFO, "unprepared"); });
+    unprepared.join();
+    logger->stopAsync();
+    LOG_CPP_REALTIME(INFO, "synchronous");
+    ok &= check("unprepared thread and synchronous mode count drops",
+                logger->getDroppedRealtimeEntries() - droppedBefore == 2);
+
+    return ok ? 0 : 1;
+}
@@ -1,12 +1,25 @@
 #include "../Includes/Logger.hpp"
 #include "../Includes/FileRotatingHandler.hpp"
+#include "TestCheck.hpp"
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <string>
+
+// Whole contents of a file, or "" if it does not exist
+static std::string readFile(const std::string &path)
+{
+    std::ifstream in(path);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
 
 int main()
 {
     // Clean up old test logs
-    system("rm -f test_msg_only.log* test_compact.log* test_full.log* test_custom.log* 2>/dev/null");
+    system("rm -f test_msg_only.log* test_compact.log* test_full.log* test_custom.log* test_oversized.log* 2>/dev/null");
 
     Logger::initialize("RotationTest", LogLevel::DEBUG1);
 
@@ -78,5 +91,25 @@ int main()
     std::cout << "  - test_full.log → full format (timestamp, level, component, etc.)\n";
     std::cout << "  - test_custom.log → custom format with time and level\n";
 
-    return 0;
+    // Lines larger than maxFileSize: each lands whole in a file of its own,
+    // and no empty backup is rotated out in front of it
+    std::cout << "\n=== Lines Larger Than maxFileSize ===\n";
+    Logger::getInstance()->clearHandlers();
+    registerFileRotatingHandler("test_oversized.log", 1024, 3, messageOnly);
+    const std::string first(4000, 'a');
+    const std::string second(4000, 'b');
+    LOG_CPP_INFO(first);
+    LOG_CPP_INFO(second);
+    LOG_CPP_INFO("small line");
+    Logger::getInstance()->flush();
+
+    bool ok = true;
+    std::string files[4] = {readFile("test_oversized.log"), readFile("test_oversized.log.1"),
+                            readFile("test_oversized.log.2"), readFile("test_oversized.log.3")};
+    ok &= check("no empty backup", !files[1].empty() && !files[2].empty() && files[3].empty());
+    ok &= check("first oversized line whole in one file", files[2] == first + "\n");
+    ok &= check("second oversized line whole in one file", files[1] == second + "\n");
+    ok &= check("next line starts a new file", files[0] == "small line\n");
+
+    return ok ? 0 : 1;
 }
@@ -0,0 +1,100 @@
+#include "../Includes/Logger.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+struct Case
+{
+    const char *name;
+    std::string input;
+    std::string expected;
+};
+
+static std::string printable(const std::string &text)
+{
+    static const char hex[] = "0123456789abcdef";
+    std::string out;
+    for (unsigned char c : text)
+    {
+        if (c >= 0x20 && c < 0x7F)
+        {
+            out += static_cast<char>(c);
+        }
+        else
+        {
+            out += '<';
+            out += hex[c >> 4];
+            out += hex[c & 0xF];
+            out += '>';
+        }
+    }
+    return out;
+}
+
+static double nsPerMessage(Logger *logger, bool sanitize, const std::string &text, int iterations)
+{
+    logger->setSanitization(sanitize);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        LOG_CPP_INFO(text);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main()
+{
+    std::cout << "=== Message Sanitization ===\n";
+
+    Logger::initialize("SanitizeTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+    std::string cleaned;
+    std::string raw;
+    logger->setHandler([&cleaned](const LogEntry &entry)
+                       { cleaned = entry.message; });
+    logger->registerRawHandler([&raw](const LogEntry &entry)
+                               { raw = entry.message; });
+    logger->setSanitization(true);
+
+    const Case cases[] = {
+        {"plain", "user logged in\tfrom 10.0.0.1", "user logged in\tfrom 10.0.0.1"},
+        {"injected line", "bad user\n[2024-01-01][INFO  ] forged", "bad user\\n[2024-01-01][INFO  ] forged"},
+        {"CR LF", "a\r\nb", "a\\r\\nb"},
+        {"control bytes", std::string("bell\x07 nul", 9) + '\0' + "\x1b[31m\x7f", "bell\\x07 nul\\x00\\x1b[31m\\x7f"},
+        {"valid UTF-8", "h\xc3\xa9llo \xe2\x82\xac \xf0\x9f\x98\x80", "h\xc3\xa9llo \xe2\x82\xac \xf0\x9f\x98\x80"},
+        {"invalid byte", "x\xc3(y", "x\xef\xbf\xbd(y"},
+        {"overlong", "\xc0\xaf", "\xef\xbf\xbd\xef\xbf\xbd"},
+        {"surrogate", "\xed\xa0\x80!", "\xef\xbf\xbd\xef\xbf\xbd\xef\xbf\xbd!"},
+        {"truncated", "price \xe2\x82", "price \xef\xbf\xbd\xef\xbf\xbd"},
+        {"long, late newline", std::string(40, 'a') + "\n" + std::string(40, 'b'),
+         std::string(40, 'a') + "\\n" + std::string(40, 'b')},
+    };
+
+    bool ok = true;
+    for (const Case &test : cases)
+    {
+        LOG_CPP_INFO(test.input);
+        bool passed = cleaned == test.expected && raw == test.input;
+        ok &= passed;
+        std::cout << (passed ? "  ok   " : "  FAIL ") << test.name << ": " << printable(cleaned) << "\n";
+    }
+
+    logger->setSanitization(false);
+    LOG_CPP_INFO("off\n");
+    bool off = cleaned == "off\n";
+    std::cout << "Disabled: message passed through unchanged: " << (off ? "yes" : "NO") << "\n";
+    ok &= off;
+
+    // Clean ASCII should cost next to nothing
+    logger->setHandler([](const LogEntry &) {});
+    std::string clean = "GET /api/v1/orders?limit=50&offset=100 HTTP/1.1 200 took 3.2ms user=alice region=eu-west-1 "
+                        "request=7f3a9c2e-1b4d-4e8f-9a6b-2c5d7e8f9a0b";
+    const int iterations = 300000;
+    nsPerMessage(logger, false, clean, iterations / 10);
+    double plain = nsPerMessage(logger, false, clean, iterations);
+    double sanitized = nsPerMessage(logger, true, clean, iterations);
+    std::cout << "Clean " << clean.size() << "-byte message: " << plain << " ns without, " << sanitized
+              << " ns with sanitization\n";
+
+    return ok ? 0 : 1;
+}
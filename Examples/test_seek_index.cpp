@@ -0,0 +1,135 @@
+#include "../Includes/Logger.hpp"
+#include "../Includes/FileRotatingHandler.hpp"
+#include "../Includes/LogFraming.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+static std::string readFile(const std::string &path)
+{
+    std::ifstream input(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+}
+
+static int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+static size_t countOccurrences(const std::string &text, const std::string &needle)
+{
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + needle.size()))
+    {
+        ++count;
+    }
+    return count;
+}
+
+// Run a query and return the text of all blocks passed on
+static std::string query(const std::string &data, const LogFrameQuery &range, unsigned threads = 0)
+{
+    std::string text;
+    queryLogFrames(data.data(), data.size(), range, [&text](const char *payload, size_t size)
+                   { text.append(payload, size); }, threads);
+    return text;
+}
+
+static void logPhase(int phase, int count)
+{
+    Logger *logger = Logger::getInstance();
+    logger->startAsync();
+    for (int i = 0; i < count; ++i)
+    {
+        if (phase == 2)
+        {
+            LOG_CPP_WARN("phase ", phase, " message ", i);
+        }
+        else
+        {
+            LOG_CPP_INFO("phase ", phase, " message ", i);
+        }
+    }
+    logger->stopAsync();
+}
+
+int main()
+{
+    // Clean up old test logs
+    system("rm -f test_seek.log* 2>/dev/null");
+
+    std::cout << "=== Seekable Compressed Segments ===\n";
+
+    Logger::initialize("SeekTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+    logger->clearHandlers();
+
+    FileRotatingHandler::Options options;
+    options.compress = true;
+    options.blockSize = 8 * 1024;
+    registerFileRotatingHandler("test_seek.log", 64 * 1024 * 1024, 2, options);
+
+    // Four phases, well apart in time
+    const int perPhase = 20000;
+    int64_t phaseStart[5];
+    for (int phase = 0; phase < 4; ++phase)
+    {
+        phaseStart[phase] = nowNs();
+        logPhase(phase, perPhase);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    phaseStart[4] = nowNs();
+
+    // Removing the handlers closes the file with its seek table
+    logger->clearHandlers();
+
+    std::string data = readFile("test_seek.log");
+    LogFrameIndex index = readLogFrameIndex(data.data(), data.size());
+    std::cout << "Seek table:   " << index.entries.size() << " runs, " << index.unindexedSize
+              << " bytes unindexed\n";
+
+    LogFrameQuery phase1;
+    phase1.fromNs = phaseStart[1];
+    phase1.toNs = phaseStart[2] - 1;
+    std::string text = query(data, phase1);
+    size_t phase1Lines = countOccurrences(text, "phase 1 ");
+    size_t returnedLines = countOccurrences(text, "\n");
+    std::cout << "Time range:   " << phase1Lines << " of " << perPhase << " phase 1 lines, "
+              << returnedLines << " lines decompressed of " << 4 * perPhase << "\n";
+    bool sameSerial = query(data, phase1, 1) == text;
+
+    LogFrameQuery warnings;
+    warnings.levelMask = 1u << static_cast<unsigned>(LogLevel::WARN);
+    std::string warnText = query(data, warnings);
+    size_t warnLines = countOccurrences(warnText, "phase 2 ");
+    std::cout << "Level mask:   " << warnLines << " of " << perPhase << " WARN lines, "
+              << countOccurrences(warnText, "\n") << " lines decompressed\n";
+
+    // A second session appending to the file chains a second seek table
+    registerFileRotatingHandler("test_seek.log", 64 * 1024 * 1024, 2, options);
+    logPhase(4, perPhase);
+    logger->clearHandlers();
+    data = readFile("test_seek.log");
+    LogFrameIndex chained = readLogFrameIndex(data.data(), data.size());
+    size_t allLines = countOccurrences(query(data, LogFrameQuery()), "\n");
+    std::cout << "Appended:     " << chained.entries.size() << " runs, " << chained.unindexedSize
+              << " bytes unindexed, " << allLines << " lines in total\n";
+
+    // Without its seek table (a crash), the whole file is read
+    std::string crashed = data.substr(0, data.size() - 1);
+    LogFrameIndex none = readLogFrameIndex(crashed.data(), crashed.size());
+    size_t crashLines = countOccurrences(query(crashed, phase1), "phase 1 ");
+    std::cout << "No table:     " << none.unindexedSize << " bytes unindexed, " << crashLines
+              << " phase 1 lines\n";
+
+    bool ok = index.unindexedSize == 0 && !index.entries.empty() && phase1Lines == perPhase &&
+              returnedLines < 2 * perPhase && sameSerial && warnLines == perPhase &&
+              chained.unindexedSize == 0 && chained.entries.size() > index.entries.size() &&
+              allLines == 5 * perPhase && none.unindexedSize == crashed.size() && crashLines == perPhase;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+#include "../Includes/Logger.hpp"
+#include "../Includes/LogSignalSafe.hpp"
+#include "../Includes/Logger_C.h"
+#include "TestCheck.hpp"
+#include <climits>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+struct Captured
+{
+    std::string function;
+    std::string message;
+    LogLevel level;
+};
+
+static std::vector<Captured> captured;
+static bool raiseInsideHandler = false;
+
+static void onSignal(int signal)
+{
+    LOG_CPP_SIGNAL_SAFE(WARN, "caught signal ", signal, " ratio=", -2.5, " ok=", true, " min=", LLONG_MIN);
+}
+
+static void onFloodSignal(int)
+{
+    LOG_CPP_SIGNAL_SAFE(INFO, "flood");
+}
+
+static void onCSignal(int)
+{
+    LOG_SIGNAL_SAFE(LOG_ERROR, "from C");
+}
+
+static void onTerminate(int)
+{
+    LOG_CPP_SIGNAL_SAFE(WARN, "terminating");
+}
+
+static size_t countMessages(const std::string &text)
+{
+    size_t count = 0;
+    for (const Captured &entry : captured)
+    {
+        count += entry.message == text;
+    }
+    return count;
+}
+
+int main()
+{
+    std::cout << "=== Async-Signal-Safe Logging ===\n";
+
+    Logger::initialize("SignalTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+    logger->setHandler([](const LogEntry &entry)
+                       {
+        captured.push_back({entry.function, entry.message, entry.severity});
+        if (raiseInsideHandler)
+        {
+            // A signal while the handlers are running: must not deadlock
+            raiseInsideHandler = false;
+            std::raise(SIGUSR1);
+        } });
+
+    std::signal(SIGUSR1, onSignal);
+    bool ok = true;
+
+    // Synchronous: written by the next flush() or log call
+    std::raise(SIGUSR1);
+    ok &= check("nothing written from inside the signal handler", captured.empty());
+    logger->flush();
+    const std::string expected =
+        "caught signal " + std::to_string(SIGUSR1) + " ratio=-2.500000 ok=true min=-9223372036854775808";
+    ok &= check("entry written at flush()", captured.size() == 1 && captured[0].message == expected &&
+                                               captured[0].function == "onSignal" &&
+                                               captured[0].level == LogLevel::WARN);
+
+    raiseInsideHandler = true;
+    LOG_CPP_INFO("ordinary entry");
+    LOG_CPP_INFO("next entry");
+    ok &= check("signal during dispatch picked up by the next log call",
+                captured.size() == 4 && captured[1].message == "ordinary entry" && captured[2].message == expected &&
+                    captured[3].message == "next entry");
+
+    // Below the threshold: not queued at all
+    logger->setLogLevel(LogLevel::ERROR);
+    std::raise(SIGUSR1);
+    logger->flush();
+    logger->setLogLevel(LogLevel::INFO);
+    ok &= check("level filtered in the signal handler", captured.size() == 4);
+
+    // Synchronous, with no log call between the signal and exit: the exit
+    // hook writes the entry
+    int pipeFds[2];
+    if (pipe(pipeFds) != 0)
+    {
+        return 1;
+    }
+    std::cout.flush();
+    pid_t child = fork();
+    if (child == 0)
+    {
+        close(pipeFds[0]);
+        int out = pipeFds[1];
+        logger->setHandler([out](const LogEntry &entry)
+                           {
+            std::string line = std::string(entry.message.data(), entry.message.size()) + "\n";
+            ssize_t written = write(out, line.data(), line.size());
+            (void)written; });
+        std::signal(SIGTERM, onTerminate);
+        std::raise(SIGTERM);
+        std::exit(0);
+    }
+    close(pipeFds[1]);
+    std::string fromChild;
+    char chunk[256];
+    ssize_t length;
+    while ((length = read(pipeFds[0], chunk, sizeof(chunk))) > 0)
+    {
+        fromChild.append(chunk, static_cast<size_t>(length));
+    }
+    close(pipeFds[0]);
+    int status = 0;
+    waitpid(child, &status, 0);
+    ok &= check("entry queued just before exit written at exit", fromChild == "terminating\n");
+
+
+    // Asynchronous: the backend drains the queue, signals from several threads
+    captured.clear();
+    logger->startAsync();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([]()
+                             {
+            for (int i = 0; i < 10; ++i)
+            {
+                std::raise(SIGUSR1);
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    logger->flush();
+    ok &= check("40 entries from 4 threads written by the backend", countMessages(expected) == 40);
+    logger->stopAsync();
+
+    // The C macro
+    std::signal(SIGUSR2, onCSignal);
+    std::raise(SIGUSR2);
+    logger->flush();
+    ok &= check("C API", countMessages("from C") == 1 && captured.back().level == LogLevel::ERROR);
+
+    // More signals than the queue holds before anything drains: the excess is
+    // dropped and counted
+    captured.clear();
+    std::signal(SIGUSR1, onFloodSignal);
+    for (int i = 0; i < 300; ++i)
+    {
+        std::raise(SIGUSR1);
+    }
+    logger->flush();
+    uint64_t dropped = logger->getDroppedSignalSafeEntries();
+    std::cout << "Flood: " << countMessages("flood") << " written, " << dropped << " dropped\n";
+    ok &= check("queue full: entries dropped, none lost silently", countMessages("flood") + dropped == 300 && dropped > 0);
+
+    // The formatter cuts long messages
+    char buffer[16];
+    LogSignalSafeFormatter formatter(buffer, sizeof(buffer));
+    formatter << "0123456789" << 123456789 << static_cast<const void *>(buffer);
+    ok &= check("formatter output cut at its capacity", formatter.str().size() == 15 &&
+                                                            std::string(buffer) == "012345678912345");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+#include "../Includes/Logger.hpp"
+#include "../Includes/LogSpan.hpp"
+#include "../Includes/ChromeTraceHandler.hpp"
+#include "TestCheck.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SpanEntry
+{
+    std::string message;
+    std::string name;
+    uint64_t durationNs;
+    int64_t timestampNs;
+};
+
+static std::vector<SpanEntry> spans;
+
+static void parse()
+{
+    LOG_CPP_SPAN("parse");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+static void handleRequest()
+{
+    LOG_CPP_SPAN_AT(INFO, "request");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    parse();
+}
+
+static size_t countOccurrences(const std::string &text, const std::string &needle)
+{
+    size_t count = 0;
+    for (size_t position = text.find(needle); position != std::string::npos; position = text.find(needle, position + 1))
+    {
+        ++count;
+    }
+    return count;
+}
+
+int main()
+{
+    system("rm -f test_spans.json 2>/dev/null");
+    std::cout << "=== Timing Spans ===\n";
+
+    Logger::initialize("SpanTest", LogLevel::DEBUG1);
+    Logger *logger = Logger::getInstance();
+    logger->setHandler([](const LogEntry &entry)
+                       {
+        if (entry.fieldCount == 2)
+        {
+            spans.push_back({entry.message, entry.fields[0].stringValue, entry.fields[1].uintValue, entry.timestampNs});
+        } });
+    registerChromeTraceHandler("test_spans.json");
+
+    bool ok = true;
+
+    // Synchronous: the inner span ends, and is written, first
+    handleRequest();
+    for (const SpanEntry &span : spans)
+    {
+        std::cout << "  " << span.message << "\n";
+    }
+    ok &= check("nested spans written innermost first",
+                spans.size() == 2 && spans[0].name == "parse" && spans[1].name == "request");
+    ok &= check("durations measured from the tick counter",
+                spans.size() == 2 && spans[0].durationNs >= 1000000 && spans[0].durationNs < 50000000 &&
+                    spans[1].durationNs >= 3000000 && spans[1].durationNs >= spans[0].durationNs);
+    ok &= check("timestamp is the start of the span",
+                spans.size() == 2 && spans[1].timestampNs <= spans[0].timestampNs &&
+                    spans[0].timestampNs + static_cast<int64_t>(spans[0].durationNs) <=
+                        spans[1].timestampNs + static_cast<int64_t>(spans[1].durationNs) + 100000);
+    ok &= check("message reads \"<name> took <us>us\"",
+                spans.size() == 2 && spans[0].message.compare(0, 11, "parse took ") == 0 &&
+                    spans[0].message.substr(spans[0].message.size() - 2) == "us");
+
+    LOG_CPP_INFO("between requests");
+
+    // Asynchronous, from several threads
+    logger->startAsync();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t)
+    {
+        threads.emplace_back([t]()
+                             {
+            Logger::setThreadName("worker-" + std::to_string(t));
+            for (int i = 0; i < 50; ++i)
+            {
+                LOG_CPP_SPAN("step");
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    logger->flush();
+    size_t steps = 0;
+    for (const SpanEntry &span : spans)
+    {
+        steps += span.name == "step";
+    }
+    ok &= check("spans queued from 3 threads and written by the backend", steps == 150);
+
+    logger->stopAsync();
+
+    // Removing the handlers closes the trace
+    logger->clearHandlers();
+    std::ifstream in("test_spans.json");
+    std::stringstream contents;
+    contents << in.rdbuf();
+    std::string trace = contents.str();
+    std::cout << "Trace: " << trace.size() << " bytes, starts " << trace.substr(0, 120) << "...\n";
+    ok &= check("trace is a closed JSON array", trace.compare(0, 2, "[\n") == 0 && trace.substr(trace.size() - 3) == "\n]\n");
+    ok &= check("one complete event per span",
+                countOccurrences(trace, "\"ph\":\"X\"") == 2 + 150 &&
+                    trace.find("{\"name\":\"parse\",\"cat\":\"SpanTest\",\"ph\":\"X\",\"ts\":") != std::string::npos);
+    ok &= check("ordinary entries as instant events", trace.find("\"name\":\"between requests\"") != std::string::npos &&
+                                                          countOccurrences(trace, "\"ph\":\"i\"") == 1);
+    ok &= check("thread names as metadata", trace.find("\"args\":{\"name\":\"worker-2\"}") != std::string::npos);
+
+    // Producer cost per span, in a burst that fits the slab, and when
+    // filtered out
+    logger->setHandler([](const LogEntry &) {});
+    AsyncLogOptions options;
+    options.prefault = true;
+    logger->startAsync(options);
+    const int iterations = 10000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        LOG_CPP_SPAN("tight");
+    }
+    double enabledNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+    logger->setLogLevel(LogLevel::INFO);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        LOG_CPP_SPAN("tight");
+    }
+    double disabledNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+    std::cout << "Span cost: " << enabledNs << " ns queued, " << disabledNs << " ns below the threshold\n";
+    logger->stopAsync();
+
+    system("rm -f test_spans.json 2>/dev/null");
+    return ok ? 0 : 1;
+}
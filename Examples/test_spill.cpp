@@ -0,0 +1,154 @@
+#include "../Includes/Logger.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+static const char *SPILL_PATH = "test_spill.spill";
+
+static long fileSize(const char *path)
+{
+    struct stat statbuf;
+    return stat(path, &statbuf) == 0 ? static_cast<long>(statbuf.st_size) : -1;
+}
+
+// Checks that each producer's messages arrive complete and in order. Messages
+// look like "<producer> <sequence>".
+struct OrderCheck
+{
+    std::mutex mutex;
+    std::map<std::string, long> next;
+    long received = 0;
+    long outOfOrder = 0;
+
+    void receive(const LogEntry &entry)
+    {
+        std::string message = entry.message;
+        size_t space = message.find(' ');
+        if (space == std::string::npos)
+        {
+            return;
+        }
+        std::string producer = message.substr(0, space);
+        long sequence = std::atol(message.c_str() + space + 1);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = next.find(producer);
+        if (found != next.end() && sequence < found->second)
+        {
+            ++outOfOrder;
+        }
+        next[producer] = sequence + 1;
+        ++received;
+    }
+};
+
+// A process whose sink is stuck, killed while records sit in the spill file
+static void crashingChild()
+{
+    Logger::initialize("SpillChild", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+    logger->setHandler([](const LogEntry &)
+                       { std::this_thread::sleep_for(std::chrono::seconds(60)); });
+
+    AsyncLogOptions options;
+    options.slabSize = 4096;
+    options.spillPath = SPILL_PATH;
+    logger->startAsync(options);
+    for (int i = 0; i < 1000; ++i)
+    {
+        LOG_CPP_INFO("crashed ", i);
+    }
+    _exit(0);
+}
+
+int main()
+{
+    system("rm -f test_spill.spill 2>/dev/null");
+    std::cout << "=== Disk Spill ===\n";
+
+    // Part 1: a process dies with records spilled; the next one replays them
+    pid_t child = fork();
+    if (child == 0)
+    {
+        crashingChild();
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    long leftOver = fileSize(SPILL_PATH);
+    std::cout << "Spill file left by the dead process: " << leftOver << " bytes\n";
+
+    Logger::initialize("SpillTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+    OrderCheck recovered;
+    logger->setHandler([&recovered](const LogEntry &entry)
+                       { recovered.receive(entry); });
+
+    AsyncLogOptions options;
+    options.slabSize = 4096;
+    options.spillPath = SPILL_PATH;
+    logger->startAsync(options);
+    logger->flush();
+    logger->stopAsync();
+    std::cout << "Replayed at startup: " << recovered.received << " records, " << recovered.outOfOrder
+              << " out of order\n";
+
+    // Part 2: producers outrun a slow sink; the overflow goes to disk and
+    // comes back complete and in order
+    OrderCheck overload;
+    std::atomic<long> maxSpill(0);
+    logger->setHandler([&overload, &maxSpill](const LogEntry &entry)
+                       {
+        overload.receive(entry);
+        if (overload.received % 500 == 0)
+        {
+            long size = fileSize(SPILL_PATH);
+            if (size > maxSpill.load())
+            {
+                maxSpill.store(size);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } });
+
+    const int producers = 4;
+    const int perProducer = 20000;
+    auto start = std::chrono::steady_clock::now();
+    logger->startAsync(options);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producers; ++t)
+    {
+        threads.emplace_back([t]()
+                             {
+            std::string name = "p" + std::to_string(t);
+            for (int i = 0; i < perProducer; ++i)
+            {
+                LOG_CPP_INFO(name, " ", i);
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    auto produced = std::chrono::steady_clock::now();
+    logger->stopAsync();
+
+    std::cout << "Overload: " << overload.received << " of " << producers * perProducer << " records, "
+              << overload.outOfOrder << " out of order, spill file peaked at " << maxSpill.load() << " bytes\n";
+    std::cout << "Producers finished in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(produced - start).count()
+              << " ms without waiting for the sink\n";
+    std::cout << "Spill file after stop: " << (fileSize(SPILL_PATH) < 0 ? "removed" : "still present") << "\n";
+
+    bool ok = leftOver > 0 && recovered.received > 900 && recovered.outOfOrder == 0 &&
+              overload.received == producers * perProducer && overload.outOfOrder == 0 && maxSpill.load() > 0 &&
+              fileSize(SPILL_PATH) < 0;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+#include "../Includes/Logger.hpp"
+#include "TestCheck.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// A "Vm...:  123 kB" line of /proc/self/status, in kB
+static long statusKb(const std::string &key)
+{
+    std::ifstream in("/proc/self/status");
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.compare(0, key.size() + 1, key + ":") == 0)
+        {
+            return std::stol(line.substr(key.size() + 1));
+        }
+    }
+    return -1;
+}
+
+static long threadMinorFaults()
+{
+    rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_minflt;
+}
+
+int main()
+{
+    std::cout << "=== Warm-Up ===\n";
+
+    const size_t slabSize = 256 * 1024;
+    LogWarmupOptions warmup;
+    warmup.lockMemory = true;
+    Logger::initialize("WarmupTest", LogLevel::INFO, nullptr, warmup);
+    Logger *logger = Logger::getInstance();
+    logger->setHandler([](const LogEntry &) {});
+
+    bool ok = true;
+
+    AsyncLogOptions options;
+    options.slabSize = slabSize; // Not prefaulted here; the warm-up does it
+    long lockedBefore = statusKb("VmLck");
+    logger->startAsync(options);
+
+    // Locking needs RLIMIT_MEMLOCK room (or CAP_IPC_LOCK)
+    rlimit limit;
+    getrlimit(RLIMIT_MEMLOCK, &limit);
+    long locked = statusKb("VmLck") - lockedBefore;
+    std::cout << "Locked by the caller's slab: " << locked << " kB\n";
+    if (limit.rlim_cur == RLIM_INFINITY || limit.rlim_cur >= 4 * slabSize || geteuid() == 0)
+    {
+        ok &= check("slab locked in memory", locked >= static_cast<long>(slabSize / 1024));
+    }
+
+    // A warmed thread takes no page faults on its slab while logging
+    long faults = -1;
+    double firstNs = 0;
+    double steadyNs = 0;
+    std::thread worker([&]()
+                       {
+        Logger::getInstance()->warmThread();
+        long before = threadMinorFaults();
+        auto start = std::chrono::steady_clock::now();
+        LOG_CPP_INFO("first message ", 1);
+        firstNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        for (int i = 0; i < 1000; ++i)
+        {
+            LOG_CPP_INFO("request ", i, " served in ", 0.25 * i, "ms");
+        }
+        faults = threadMinorFaults() - before;
+
+        std::vector<double> samples;
+        for (int i = 0; i < 200; ++i)
+        {
+            start = std::chrono::steady_clock::now();
+            LOG_CPP_INFO("steady message ", i);
+            samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        steadyNs = samples[samples.size() / 2]; });
+    worker.join();
+    logger->flush();
+    std::cout << "Minor faults over 1001 messages: " << faults << "\n";
+    std::cout << "First message: " << firstNs << " ns, steady median: " << steadyNs << " ns\n";
+    ok &= check("no slab page faults after warmThread()", faults >= 0 && faults < 8);
+
+    logger->stopAsync();
+
+    // Synchronous mode: warming a thread creates no slab
+    std::thread synchronous([&]()
+                            {
+        Logger::getInstance()->warmThread();
+        LOG_CPP_INFO("synchronous after warm-up"); });
+    synchronous.join();
+    ok &= check("warmThread() is harmless in synchronous mode", true);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+#include "../Includes/Logger.hpp"
+#include "TestCheck.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// A handler that blocks while `stalled` is set, as on a hung network mount
+struct BlockingSink
+{
+    std::atomic<bool> stalled{false};
+    std::mutex mutex;
+    std::vector<std::string> messages;
+    std::vector<std::string> functions;
+
+    void write(const LogEntry &entry)
+    {
+        while (stalled.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.push_back(entry.message);
+        functions.push_back(entry.function);
+    }
+
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return messages.size();
+    }
+};
+
+static bool waitUntilDrained(Logger *logger, size_t handler)
+{
+    for (int i = 0; i < 5000; ++i)
+    {
+        if (logger->getHandlerStats()[handler].queued == 0)
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+int main()
+{
+    std::cout << "=== Slow-Handler Watchdog ===\n";
+
+    Logger::initialize("WatchdogTest", LogLevel::INFO);
+    Logger *logger = Logger::getInstance();
+
+    std::vector<std::string> fast;
+    BlockingSink slow;
+    logger->setHandler([&fast](const LogEntry &entry)
+                       { fast.push_back(entry.message); });
+    logger->registerHandler([&slow](const LogEntry &entry)
+                            { slow.write(entry); });
+    logger->setHandlerWatchdog(20000);
+
+    bool ok = true;
+
+    // The first stall moves the handler to a thread of its own
+    slow.stalled = true;
+    std::thread release([&slow]()
+                        {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        slow.stalled = false; });
+    LOG_CPP_INFO("first");
+    release.join();
+    std::vector<LogHandlerStats> stats = logger->getHandlerStats();
+    ok &= check("stalled handler isolated, the other left alone",
+                stats.size() == 2 && stats[0].state == LogHandlerState::DIRECT &&
+                    stats[1].state == LogHandlerState::ISOLATED && stats[1].slowestNs >= 50000000 &&
+                    stats[0].slowestNs < stats[1].slowestNs);
+
+    // Further stalls no longer hold up the logging thread
+    slow.stalled = true;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i)
+    {
+        LOG_CPP_INFO("next ", i);
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "100 entries with the isolated handler stalled: " << elapsedMs << " ms\n";
+    ok &= check("logging thread not blocked", elapsedMs < 20 && fast.size() == 101);
+    ok &= check("entries queued for the isolated handler", logger->getHandlerStats()[1].queued == 100);
+
+    slow.stalled = false;
+    ok &= check("isolated handler catches up", waitUntilDrained(logger, 1));
+    {
+        std::lock_guard<std::mutex> lock(slow.mutex);
+        ok &= check("queued entries complete and in order",
+                    slow.messages.size() == 101 && slow.messages[0] == "first" && slow.messages[100] == "next 99" &&
+                        slow.functions[100] == "main");
+    }
+
+    // A full queue drops entries and counts them
+    slow.stalled = true;
+    for (int i = 0; i < 5000; ++i)
+    {
+        LOG_CPP_INFO("burst ", i);
+    }
+    stats = logger->getHandlerStats();
+    std::cout << "Burst of 5000: " << stats[1].queued << " queued, " << stats[1].dropped << " dropped\n";
+    ok &= check("overflow dropped and counted", stats[1].dropped > 0 && stats[1].queued + stats[1].dropped == 5000);
+    slow.stalled = false;
+    waitUntilDrained(logger, 1);
+    ok &= check("counters add up", logger->getHandlerStats()[1].calls == slow.size() && slow.size() == 101 + 5000 - stats[1].dropped);
+
+    // stopAsync() lets the isolated handler write its queue and joins its
+    // thread, so the objects it uses can be torn down afterwards
+    logger->startAsync();
+    slow.stalled = true;
+    size_t written = slow.size();
+    for (int i = 0; i < 10; ++i)
+    {
+        LOG_CPP_INFO("async ", i);
+    }
+    logger->flush();
+    std::thread unstall([&slow]()
+                        {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        slow.stalled = false; });
+    logger->stopAsync();
+    bool complete = slow.size() == written + 10;
+    unstall.join();
+    stats = logger->getHandlerStats();
+    ok &= check("stopAsync() waits for the isolated handler and joins its thread",
+                complete && stats[1].state == LogHandlerState::DIRECT && stats[1].queued == 0);
+
+    // A handler that stays blocked is given up on, with a warning
+    logger->startAsync();
+    slow.stalled = true;
+    std::thread unstallOnce([&slow]()
+                            {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        slow.stalled = false; });
+    LOG_CPP_INFO("isolated again");
+    logger->flush();
+    unstallOnce.join();
+    slow.stalled = true;
+    for (int i = 0; i < 3; ++i)
+    {
+        LOG_CPP_INFO("stuck ", i);
+    }
+    logger->flush();
+    uint64_t droppedBefore = logger->getHandlerStats()[1].dropped;
+    start = std::chrono::steady_clock::now();
+    logger->stopAsync();
+    elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stats = logger->getHandlerStats();
+    std::cout << "stopAsync() with the handler blocked: " << elapsedMs << " ms\n";
+    ok &= check("blocked handler disabled, its queue dropped",
+                elapsedMs >= 1000 && stats[1].state == LogHandlerState::DISABLED &&
+                    stats[1].dropped == droppedBefore + 2);
+    // Let the abandoned call finish before `slow` goes away
+    slow.stalled = false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Disabling instead of isolating
+    logger->setHandler([&slow](const LogEntry &entry)
+                       { slow.write(entry); });
+    logger->setHandlerWatchdog(20000, false);
+    slow.stalled = true;
+    std::thread releaseAgain([&slow]()
+                             {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        slow.stalled = false; });
+    size_t before = slow.size();
+    LOG_CPP_INFO("stalls once");
+    releaseAgain.join();
+    LOG_CPP_INFO("not written");
+    ok &= check("stalled handler disabled",
+                logger->getHandlerStats()[0].state == LogHandlerState::DISABLED && slow.size() == before + 1);
+
+    // fork() does not wait for a blocked handler, and the child starts a
+    // logger of its own
+    logger->setHandlerWatchdog(0);
+    logger->setHandler([&slow](const LogEntry &entry)
+                       { slow.write(entry); });
+    slow.stalled = true;
+    std::thread blocked([]()
+                        { LOG_CPP_INFO("blocked in the handler"); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    int pipeFds[2];
+    if (pipe(pipeFds) != 0)
+    {
+        return 1;
+    }
+    std::cout.flush();
+    start = std::chrono::steady_clock::now();
+    pid_t child = fork();
+    if (child == 0)
+    {
+        close(pipeFds[0]);
+        int out = pipeFds[1];
+        Logger::initialize("ChildTest", LogLevel::INFO);
+        Logger::getInstance()->setHandler([out](const LogEntry &entry)
+                                          {
+            std::string line = std::string(entry.component) + " " + std::string(entry.message);
+            ssize_t written = write(out, line.data(), line.size());
+            (void)written; });
+        LOG_CPP_INFO("from the child");
+        _exit(0);
+    }
+    elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    close(pipeFds[1]);
+    std::string fromChild;
+    char chunk[256];
+    ssize_t length;
+    while ((length = read(pipeFds[0], chunk, sizeof(chunk))) > 0)
+    {
+        fromChild.append(chunk, static_cast<size_t>(length));
+    }
+    close(pipeFds[0]);
+    waitpid(child, nullptr, 0);
+    slow.stalled = false;
+    blocked.join();
+    std::cout << "fork() with a handler blocked: " << elapsedMs << " ms\n";
+    ok &= check("fork() not held up by a blocked handler", elapsedMs < 100);
+    ok &= check("child logs through a logger of its own", fromChild == "ChildTest from the child");
+
+    // Watchdog off: nothing is timed
+    logger->setHandlerWatchdog(0);
+    logger->setHandler([](const LogEntry &) {});
+    LOG_CPP_INFO("untimed");
+    stats = logger->getHandlerStats();
+    ok &= check("off by default: calls counted, not timed", stats[0].calls == 1 && stats[0].slowestNs == 0);
+
+    return ok ? 0 : 1;
+}
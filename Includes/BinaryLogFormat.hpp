@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Logger.hpp"
+#include "LogEncoder.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+/**
+ * Binary log format - compact, self-describing records for machine consumers
+ *
+ * A file is a sequence of segments. Every record starts with a one-byte tag;
+ * integers are LEB128 varints (signed ones zigzag-encoded first):
+ *
+ *   SEGMENT  "L4CB", version, base timestamp (ns)
+ *            Starts a segment and clears its string and site tables.
+ *   STRING   length, bytes
+ *            Adds the next string id (0, 1, 2, ...) to the segment table.
+ *   SITE     file string id, function string id, line
+ *            Adds the next site id; a site is one logging call location.
+ *   ENTRY    level, timestamp delta (signed, from the previous entry or the
+ *            segment base), site id, component string id, thread id,
+ *            thread name string id, process id, message length + bytes,
+ *            field count, then per field: key string id, type tag, value
+ *
+ * Field values are tagged with LogFieldType: INT (signed varint), UINT
+ * (varint), DOUBLE (8 bytes, little-endian IEEE 754), BOOL (1 byte) and
+ * STRING (length + bytes).
+ *
+ * Strings and sites are defined right before the first entry that uses them,
+ * so a segment can be decoded without anything written before it.
+ */
+
+#define LOG4CPP_BINARY_MAGIC "L4CB"
+#define LOG4CPP_BINARY_VERSION 1
+
+enum BinaryRecordTag : uint8_t
+{
+    BINARY_TAG_SEGMENT = 0x00,
+    BINARY_TAG_STRING = 0x01,
+    BINARY_TAG_SITE = 0x02,
+    BINARY_TAG_ENTRY = 0x03
+};
+
+/**
+ * BinaryLogEncoder - LogEncoder writing the binary log format
+ *
+ * Usage:
+ *   registerFileRotatingHandler("app.bin", 64*1024*1024, 5,
+ *                               std::make_shared<BinaryLogEncoder>());
+ */
+class BinaryLogEncoder : public LogEncoder
+{
+public:
+    BinaryLogEncoder();
+    ~BinaryLogEncoder() override;
+
+    void beginSegment() override;
+    void encode(const LogEntry &entry, std::string &out) override;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+/**
+ * BinaryLogDecoder - Reads records back from binary log data
+ *
+ * Entries are returned as LogEntry views into the decoder, valid until the
+ * next call to next(), so they can be handed straight to any OutputHandler.
+ *
+ * Usage:
+ *   BinaryLogDecoder decoder(data, size);
+ *   LogEntry entry;
+ *   while (decoder.next(entry)) { ... }
+ *   if (decoder.failed()) { ... corrupt or truncated input ... }
+ */
+class BinaryLogDecoder
+{
+public:
+    // The data must stay valid while the decoder is used
+    BinaryLogDecoder(const char *data, size_t size);
+    ~BinaryLogDecoder();
+
+    // Decode the next entry; false at the end of the data or on an error
+    bool next(LogEntry &entry);
+
+    // True if decoding stopped at malformed or truncated data
+    bool failed() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+// Write one JSON object per entry of a binary log file. Returns the number
+// of entries converted, or -1 if the file cannot be read or is malformed
+// (entries before the damage are still written). Files written with
+// checksumBlocks are read block by block, skipping damaged blocks.
+long binaryLogToJsonLines(const std::string &path, std::ostream &out);
+
+// Append entry as a single-line JSON object (no trailing newline)
+void appendLogEntryJson(const LogEntry &entry, std::string &out);
+
+// Append text as a quoted JSON string, escaping quotes, backslashes and
+// control characters
+void appendJsonString(std::string &out, LogStringRef text);
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Logger.hpp"
+#include <memory>
+#include <string>
+
+/**
+ * ChromeTraceHandler - Writes log entries as Chrome trace-event JSON
+ *
+ * The file opens in Perfetto (ui.perfetto.dev) or chrome://tracing:
+ * - LOG_CPP_SPAN entries (see LogSpan.hpp) become complete events ("X"),
+ *   one bar per span on the thread that ran it
+ * - other entries become instant events ("i") named after the message,
+ *   unless includeMessages is off
+ * - thread names are emitted as metadata the first time a thread (or a
+ *   new name for it) is seen
+ *
+ * The file is a JSON array written in batches at each flush. It is closed
+ * with "]" when the handlers are removed or at exit; the trace viewers also
+ * accept a file cut short by a crash.
+ *
+ * Example:
+ *   registerChromeTraceHandler("trace.json");
+ *   Logger::getInstance()->setLogLevel(LogLevel::DEBUG1); // Spans default to DEBUG1
+ */
+class ChromeTraceHandler
+{
+public:
+    /**
+     * Constructor
+     * @param path            Output file, truncated if it exists
+     * @param includeMessages Also write ordinary entries as instant events
+     */
+    explicit ChromeTraceHandler(const std::string &path, bool includeMessages = true);
+    ~ChromeTraceHandler();
+
+private:
+    // Pimpl: pointer to implementation
+    class Impl;
+    std::unique_ptr<Impl> impl;
+
+    /**
+     * Handler function - private, use registerChromeTraceHandler() instead
+     */
+    void write(const LogEntry &entry);
+
+    /**
+     * Flush handler - writes out the events of the batch
+     */
+    void flush();
+
+    /**
+     * Close handler - ends the JSON array
+     */
+    void close();
+
+    friend void registerChromeTraceHandler(const std::string &path, bool includeMessages);
+};
+
+// Convenience function: register a trace file with the logger
+void registerChromeTraceHandler(const std::string &path, bool includeMessages = true);
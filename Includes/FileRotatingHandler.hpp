@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Logger.hpp"
+#include "LogEncoder.hpp"
 #include <string>
 #include <memory>
 #include <functional>
@@ -14,6 +15,16 @@
  * - Customizable log formatting via formatter callbacks
  * - Thread-safe file operations
  * - Efficient: only rotates on threshold, not per-message
+ * - Large messages are written with writev() straight from the logger's buffer
+ * - Pluggable LogEncoder for non-text formats (e.g. BinaryLogEncoder), one
+ *   self-describing segment per file
+ * - Optional length + CRC32C framing of each batch (see LogFraming.hpp)
+ * - Optional per-batch compression; maxFileSize then limits compressed bytes
+ * - Framed files end with a seek table for time range queries (queryLogFrames)
+ * - Entries the logger cannot format for lack of memory are still written
+ *   (text and framed files), from a preallocated line
+ * - Stops writing when the disk is full or failing and resumes once there
+ *   is room again, optionally deleting the oldest backups to make room
  * - C++14 compatible (no std::filesystem)
  *
  * Examples:
@@ -23,6 +34,9 @@
  *   // Custom format (message only)
  *   auto msgOnly = [](const LogEntry &e) { return e.message; };
  *   FileRotatingHandler handler("app.log", 10*1024*1024, 5, msgOnly);
+ *
+ *   // Binary records
+ *   FileRotatingHandler handler("app.bin", 10*1024*1024, 5, std::make_shared<BinaryLogEncoder>());
  */
 class FileRotatingHandler
 {
@@ -30,6 +44,24 @@ public:
     // Formatter callback type: takes LogEntry, returns formatted string
     using Formatter = std::function<std::string(const LogEntry &)>;
 
+    // Full set of output settings
+    struct Options
+    {
+        Formatter formatter;                 // Custom text layout; default layout if empty
+        std::shared_ptr<LogEncoder> encoder; // Non-text output; takes precedence over formatter
+        bool checksumBlocks = false;         // Write each batch as a length + CRC32C framed block
+        bool compress = false;               // Compress each batch into its own framed block (implies checksumBlocks)
+        size_t blockSize = 64 * 1024;        // Batches larger than this are split into several blocks
+        bool rawMessages = false;            // Skip Logger::setSanitization(), e.g. for binary encoders
+
+        // Circuit breaker: after a failed write (disk full, I/O error) entries
+        // are counted and discarded, unformatted, until a probe of the file
+        // system every probeIntervalMs finds minFreeBytes available
+        uint32_t probeIntervalMs = 1000;
+        uint64_t minFreeBytes = 16 * 1024 * 1024;
+        bool deleteBackupsWhenFull = false;  // Delete the oldest backups until there is enough room
+    };
+
     /**
      * Constructor with default formatter
      * @param path          Base log file path (e.g., "app.log")
@@ -47,6 +79,24 @@ public:
      */
     FileRotatingHandler(const std::string &path, size_t maxSize, int backups, Formatter fmt);
 
+    /**
+     * Constructor with an encoder instead of text lines
+     * @param path          Base log file path
+     * @param maxSize       Max file size in bytes before rotation
+     * @param backups       Number of backup files to keep
+     * @param encoder       Encoder producing the file contents
+     */
+    FileRotatingHandler(const std::string &path, size_t maxSize, int backups, std::shared_ptr<LogEncoder> encoder);
+
+    /**
+     * Constructor with full options
+     * @param path          Base log file path
+     * @param maxSize       Max file size in bytes before rotation
+     * @param backups       Number of backup files to keep
+     * @param options       Layout, encoder and framing settings
+     */
+    FileRotatingHandler(const std::string &path, size_t maxSize, int backups, const Options &options);
+
     ~FileRotatingHandler();
 
 private:
@@ -59,6 +109,21 @@ private:
      */
     void write(const LogEntry &entry);
 
+    /**
+     * Flush handler - writes out the pending block at the end of a batch
+     */
+    void flush();
+
+    /**
+     * Close handler - writes the seek table of a framed file
+     */
+    void close();
+
+    /**
+     * Emergency handler - writes a preformatted line when memory runs out
+     */
+    void writeEmergency(const LogEntry &entry, LogStringRef line);
+
     // Allow convenience functions to access write()
     friend void registerFileRotatingHandler(const std::string &path, size_t maxSize, int maxBackups);
     friend void registerFileRotatingHandler(
@@ -66,6 +131,16 @@ private:
         size_t maxSize,
         int maxBackups,
         FileRotatingHandler::Formatter formatter);
+    friend void registerFileRotatingHandler(
+        const std::string &path,
+        size_t maxSize,
+        int maxBackups,
+        std::shared_ptr<LogEncoder> encoder);
+    friend void registerFileRotatingHandler(
+        const std::string &path,
+        size_t maxSize,
+        int maxBackups,
+        const FileRotatingHandler::Options &options);
 };
 
 // Convenience function for easy registration with default formatter
@@ -77,3 +152,18 @@ void registerFileRotatingHandler(
     size_t maxSize,
     int maxBackups,
     FileRotatingHandler::Formatter formatter);
+
+// Convenience function for registration with an encoder (e.g. BinaryLogEncoder);
+// registered as a raw handler, so messages are stored unsanitized
+void registerFileRotatingHandler(
+    const std::string &path,
+    size_t maxSize,
+    int maxBackups,
+    std::shared_ptr<LogEncoder> encoder);
+
+// Convenience function for registration with full options
+void registerFileRotatingHandler(
+    const std::string &path,
+    size_t maxSize,
+    int maxBackups,
+    const FileRotatingHandler::Options &options);
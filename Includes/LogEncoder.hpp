@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Logger.hpp"
+#include <string>
+
+/**
+ * LogEncoder - Turns log entries into the bytes a file handler writes
+ *
+ * Lets FileRotatingHandler write formats other than text lines. The
+ * handler calls the encoder under its file lock, so implementations need
+ * no locking of their own.
+ *
+ * Output is split into segments, one per file the handler writes. Each
+ * segment must be readable on its own, so an encoder that keeps state
+ * across entries (e.g. a string dictionary) resets it in beginSegment().
+ */
+class LogEncoder
+{
+public:
+    virtual ~LogEncoder() = default;
+
+    // A new output file was started; the next encode() opens a new segment
+    virtual void beginSegment() = 0;
+
+    // Append the encoded entry to out
+    virtual void encode(const LogEntry &entry, std::string &out) = 0;
+};
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "Logger.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Schema-defined log events - fixed-shape structured records
+ *
+ * LOG4CPP_EVENT declares a plain struct plus a compile-time description of
+ * its fields. Logging an event copies the struct as raw bytes; the text
+ * message ("Fill orderId=42 px=101.5 qty=100") and the typed
+ * LogEntry::fields are produced from the schema where the entry is
+ * dispatched, which in asynchronous mode is the backend thread.
+ *
+ * Usage:
+ *   LOG4CPP_EVENT(Fill, (uint64_t, orderId), (double, px), (uint32_t, qty));
+ *
+ *   LOG_CPP_EVENT(INFO, Fill{42, 101.5, 100});
+ *
+ * Field types: integers, enums, bool, float/double and char[N] (text up to
+ * N - 1 characters). Up to 16 fields per event.
+ */
+
+// One field of an event: where it lives in the struct and how to read it
+struct LogEventField
+{
+    const char *name;
+    LogFieldType type;
+    size_t offset;
+    // Fill field's value from the bytes at data (a private copy of the
+    // event, so text fields may be terminated in place)
+    void (*load)(char *data, LogField &field);
+};
+
+struct LogEventSchema
+{
+    const char *name;
+    const LogEventField *fields;
+    size_t fieldCount;
+    size_t size; // sizeof the event struct
+};
+
+// ========== Field Type Mapping ==========
+
+template <typename T, typename Enable = void>
+struct LogEventFieldTraits; // No definition: the type cannot be used in an event
+
+template <typename T>
+struct LogEventFieldTraits<T, typename std::enable_if<std::is_same<T, bool>::value>::type>
+{
+    static constexpr LogFieldType fieldType = LogFieldType::BOOL;
+    static void load(char *data, LogField &field)
+    {
+        std::memcpy(&field.boolValue, data, sizeof(bool));
+    }
+};
+
+template <typename T>
+struct LogEventFieldTraits<T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type>
+{
+    static constexpr LogFieldType fieldType = LogFieldType::INT;
+    static void load(char *data, LogField &field)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        field.intValue = value;
+    }
+};
+
+template <typename T>
+struct LogEventFieldTraits<T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value &&
+                                                      !std::is_same<T, bool>::value>::type>
+{
+    static constexpr LogFieldType fieldType = LogFieldType::UINT;
+    static void load(char *data, LogField &field)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        field.uintValue = value;
+    }
+};
+
+template <typename T>
+struct LogEventFieldTraits<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    static constexpr LogFieldType fieldType = LogFieldType::DOUBLE;
+    static void load(char *data, LogField &field)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        field.doubleValue = static_cast<double>(value);
+    }
+};
+
+template <typename T>
+struct LogEventFieldTraits<T, typename std::enable_if<std::is_enum<T>::value>::type>
+    : LogEventFieldTraits<typename std::underlying_type<T>::type>
+{
+};
+
+template <size_t N>
+struct LogEventFieldTraits<char[N]>
+{
+    static constexpr LogFieldType fieldType = LogFieldType::STRING;
+    static void load(char *data, LogField &field)
+    {
+        data[N - 1] = '\0';
+        field.stringValue = LogStringRef(data, std::strlen(data));
+    }
+};
+
+// ========== Declaration Macros ==========
+
+#define LOG4CPP_PP_CAT_(a, b) a##b
+#define LOG4CPP_PP_CAT(a, b) LOG4CPP_PP_CAT_(a, b)
+#define LOG4CPP_PP_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, n, ...) n
+#define LOG4CPP_PP_COUNT(...) \
+    LOG4CPP_PP_COUNT_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, )
+
+// Apply m(data, field) to every (type, name) pair
+#define LOG4CPP_PP_EACH(m, data, ...) LOG4CPP_PP_CAT(LOG4CPP_PP_EACH_, LOG4CPP_PP_COUNT(__VA_ARGS__))(m, data, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_1(m, d, x) m(d, x)
+#define LOG4CPP_PP_EACH_2(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_1(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_3(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_2(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_4(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_3(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_5(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_4(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_6(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_5(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_7(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_6(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_8(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_7(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_9(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_8(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_10(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_9(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_11(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_10(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_12(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_11(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_13(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_12(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_14(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_13(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_15(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_14(m, d, __VA_ARGS__)
+#define LOG4CPP_PP_EACH_16(m, d, x, ...) m(d, x) LOG4CPP_PP_EACH_15(m, d, __VA_ARGS__)
+
+// Spelled through an alias so array types such as char[8] work as well
+template <typename T>
+struct LogEventMemberType
+{
+    using type = T;
+};
+
+#define LOG4CPP_EVENT_MEMBER_(memberType, memberName) LogEventMemberType<memberType>::type memberName;
+#define LOG4CPP_EVENT_MEMBER(event, field) LOG4CPP_EVENT_MEMBER_ field
+
+#define LOG4CPP_EVENT_FIELD_(event, memberType, memberName)                                      \
+    {#memberName, LogEventFieldTraits<memberType>::fieldType, offsetof(event, memberName),         \
+     &LogEventFieldTraits<memberType>::load},
+#define LOG4CPP_EVENT_FIELD_EXPAND_(args) LOG4CPP_EVENT_FIELD_ args
+#define LOG4CPP_EVENT_FIELD(event, field) LOG4CPP_EVENT_FIELD_EXPAND_((event, LOG4CPP_PP_EXPAND_PAIR_ field))
+#define LOG4CPP_PP_EXPAND_PAIR_(memberType, memberName) memberType, memberName
+
+// Declare event struct `name` with the given (type, field) pairs
+#define LOG4CPP_EVENT(name, ...)                                                            \
+    struct name                                                                             \
+    {                                                                                       \
+        LOG4CPP_PP_EACH(LOG4CPP_EVENT_MEMBER, name, __VA_ARGS__)                            \
+                                                                                            \
+        static const LogEventSchema &schema();                                              \
+    };                                                                                      \
+    static_assert(std::is_trivially_copyable<name>::value, "log events must be trivially copyable"); \
+    inline const LogEventSchema &name::schema()                                             \
+    {                                                                                       \
+        static const LogEventField fields[] = {                                             \
+            LOG4CPP_PP_EACH(LOG4CPP_EVENT_FIELD, name, __VA_ARGS__)};                       \
+        static const LogEventSchema description = {                                         \
+            #name, fields, sizeof(fields) / sizeof(fields[0]), sizeof(name)};               \
+        return description;                                                                 \
+    }
+
+// Log an event at `level`: LOG_CPP_EVENT(INFO, Fill{42, 101.5, 100})
+#define LOG_CPP_EVENT(level, ...) \
+    Logger::getInstance()->event(LogLevel::level, LOG_CPP_SOURCE_LOCATION, __VA_ARGS__)
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Log block framing - integrity checks for log files
+ *
+ * A framed file is a sequence of blocks, each holding one batch of output:
+ *
+ *   "L4FB"   4-byte sync marker
+ *   length   payload size, 32-bit little-endian
+ *   crc      CRC32C of the length field and the payload, 32-bit little-endian
+ *   payload  the batch as the handler would otherwise have written it
+ *
+ * Compressed output uses a second block type, each block an independent
+ * LZ4 block-format frame, so a damaged block costs only its own batch:
+ *
+ *   "L4FZ"   4-byte sync marker
+ *   length   compressed payload size, 32-bit little-endian
+ *   raw      uncompressed size, 32-bit little-endian
+ *   crc      CRC32C of both size fields and the compressed payload
+ *   payload  the batch, compressed
+ *
+ * A reader checks every block and, on a mismatch (torn write, garbage after
+ * a crash), scans forward to the next sync marker whose block verifies.
+ *
+ * When a file is closed, a seek table is appended so readers can go straight
+ * to a time range. It is an "L4FI" block (same header as "L4FB") holding:
+ *
+ *   from     offset where the indexed region starts, 64-bit
+ *   count    number of entries, 32-bit
+ *   entries  per run of consecutive blocks: offset (64-bit), size (32-bit),
+ *            oldest and newest timestamp in ns (64-bit), level mask (32-bit,
+ *            bit n set if an entry of LogLevel n is in the run)
+ *   size     size of this whole index block, 32-bit, always the last four
+ *            bytes of the file so readers can find the table from the end
+ *
+ * All fields are little-endian. A file appended to after a restart holds one
+ * table per session; each covers the region since the previous one.
+ */
+
+#define LOG4CPP_FRAME_MAGIC "L4FB"
+#define LOG4CPP_FRAME_HEADER_SIZE 12
+#define LOG4CPP_COMPRESSED_FRAME_MAGIC "L4FZ"
+#define LOG4CPP_COMPRESSED_FRAME_HEADER_SIZE 16
+#define LOG4CPP_FRAME_MAX_PAYLOAD (256u * 1024 * 1024)
+#define LOG4CPP_FRAME_INDEX_MAGIC "L4FI"
+#define LOG4CPP_FRAME_INDEX_ENTRY_SIZE 32
+
+// CRC32C (Castagnoli). Pass a previous result as crc to continue it. Uses
+// the SSE4.2 crc32 instruction when the CPU has it, a lookup table otherwise.
+uint32_t logCrc32c(const void *data, size_t size, uint32_t crc = 0);
+
+// Fill header[LOG4CPP_FRAME_HEADER_SIZE] for a block holding payload
+void makeLogFrameHeader(const char *payload, size_t size, char *header);
+
+// Append a compressed block for payload to out; stores a plain block
+// instead when compression would not make it smaller
+void appendCompressedLogFrame(const char *payload, size_t size, std::string &out);
+
+// True if data starts with a block sync marker
+bool isFramedLog(const char *data, size_t size);
+
+struct LogFrameScan
+{
+    size_t blocks;       // Blocks that verified and were passed on
+    size_t skippedBytes; // Bytes dropped as corrupt or truncated
+};
+
+// Call onBlock(payload, size) for every intact block, in file order.
+// Compressed blocks are passed on decompressed.
+LogFrameScan scanLogFrames(const char *data, size_t size,
+                           const std::function<void(const char *payload, size_t size)> &onBlock);
+
+struct LogFrameIndexEntry
+{
+    uint64_t offset;    // File offset of the first block in the run
+    uint32_t size;      // Bytes covered by the run
+    int64_t oldestNs;   // Oldest entry timestamp in the run
+    int64_t newestNs;   // Newest entry timestamp in the run
+    uint32_t levelMask; // Bit n set if the run has an entry of LogLevel n
+};
+
+// Append a seek table covering the blocks from offset `from` onwards
+void appendLogFrameIndex(const std::vector<LogFrameIndexEntry> &entries, uint64_t from, std::string &out);
+
+struct LogFrameIndex
+{
+    std::vector<LogFrameIndexEntry> entries; // In file order
+    size_t unindexedSize;                    // Leading bytes no table covers (e.g. after a crash)
+};
+
+// Read the seek tables at the end of a framed file. A file without one, e.g.
+// from a process that crashed, comes back entirely unindexed.
+LogFrameIndex readLogFrameIndex(const char *data, size_t size);
+
+struct LogFrameQuery
+{
+    int64_t fromNs = INT64_MIN; // Oldest timestamp of interest
+    int64_t toNs = INT64_MAX;   // Newest timestamp of interest
+    uint32_t levelMask = ~0u;   // Levels of interest, bit n for LogLevel n
+};
+
+// Call onBlock(payload, size), in file order, for every intact block that
+// may hold entries matching query. Only runs whose index entry overlaps the
+// query are read; they are verified and decompressed on `threads` threads
+// (0: one per core). Blocks no seek table covers are always passed on.
+LogFrameScan queryLogFrames(const char *data, size_t size, const LogFrameQuery &query,
+                            const std::function<void(const char *payload, size_t size)> &onBlock,
+                            unsigned threads = 0);
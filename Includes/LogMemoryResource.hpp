@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define LOG4CPP_HAS_PMR 1
+#endif
+#endif
+
+/**
+ * LogMemoryResource - Allocator interface for logger-owned memory
+ *
+ * Mirrors std::pmr::memory_resource for C++14 builds. The logger takes its
+ * message formatting buffers and asynchronous record slabs from the active
+ * resource: the calling thread's resource if one is set
+ * (Logger::setThreadMemoryResource), otherwise the logger-wide one
+ * (Logger::setMemoryResource), otherwise defaultLogMemoryResource().
+ *
+ * Implementations used as the logger-wide resource must be thread-safe.
+ */
+class LogMemoryResource
+{
+public:
+    virtual ~LogMemoryResource() = default;
+
+    void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        return doAllocate(bytes, alignment);
+    }
+
+    void deallocate(void *ptr, size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        doDeallocate(ptr, bytes, alignment);
+    }
+
+protected:
+    virtual void *doAllocate(size_t bytes, size_t alignment) = 0;
+    virtual void doDeallocate(void *ptr, size_t bytes, size_t alignment) = 0;
+};
+
+// Resource used when none is configured (operator new / delete)
+LogMemoryResource *defaultLogMemoryResource();
+
+/**
+ * MonotonicLogMemoryResource - Bump allocator for short-lived batch jobs
+ *
+ * Serves allocations from an optional initial buffer, then from chunks of
+ * growing size taken from the upstream resource. Deallocation is a no-op;
+ * release() returns everything at once. Not thread-safe for allocation,
+ * so use it as a per-thread resource.
+ */
+class MonotonicLogMemoryResource : public LogMemoryResource
+{
+public:
+    explicit MonotonicLogMemoryResource(LogMemoryResource *upstream = defaultLogMemoryResource());
+    MonotonicLogMemoryResource(void *buffer, size_t size, LogMemoryResource *upstream = defaultLogMemoryResource());
+    ~MonotonicLogMemoryResource() override;
+
+    MonotonicLogMemoryResource(const MonotonicLogMemoryResource &) = delete;
+    MonotonicLogMemoryResource &operator=(const MonotonicLogMemoryResource &) = delete;
+
+    // Free all upstream chunks and start over from the initial buffer
+    void release();
+
+protected:
+    void *doAllocate(size_t bytes, size_t alignment) override;
+    void doDeallocate(void *, size_t, size_t) override {}
+
+private:
+    struct Chunk
+    {
+        void *memory;
+        size_t size;
+    };
+
+    LogMemoryResource *upstream;
+    char *initialBuffer;
+    size_t initialSize;
+    char *current;
+    size_t remaining;
+    size_t nextChunkSize;
+    std::vector<Chunk> chunks;
+};
+
+#ifdef LOG4CPP_HAS_PMR
+// Adapter so a std::pmr::memory_resource (e.g. a per-request arena) can be
+// handed to the logger
+class PmrLogMemoryResource : public LogMemoryResource
+{
+public:
+    explicit PmrLogMemoryResource(std::pmr::memory_resource *resource) : upstream(resource) {}
+
+protected:
+    void *doAllocate(size_t bytes, size_t alignment) override
+    {
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void doDeallocate(void *ptr, size_t bytes, size_t alignment) override
+    {
+        upstream->deallocate(ptr, bytes, alignment);
+    }
+
+private:
+    std::pmr::memory_resource *upstream;
+};
+#endif
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "Logger.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Real-time logging - bounded-latency producer path for control threads
+ *
+ * LOG_CPP_REALTIME does not format. It encodes its arguments as tagged raw
+ * values into a buffer on the stack, then copies them into the calling
+ * thread's preallocated record slab. The backend thread turns them into the
+ * same text LOG_CPP_INFO and friends would produce. The producer takes no
+ * lock, does not allocate, makes no system call and never waits: if the
+ * slab is full, the entry is dropped and counted.
+ *
+ * Requirements, all met before the real-time loop starts:
+ *   - asynchronous mode is on (startAsync(); prefault = true also avoids
+ *     page faults on the first pass through the slab)
+ *   - the thread has called Logger::prepareRealtimeThread()
+ * Entries from a thread that is not prepared, or logged while asynchronous
+ * mode is off, are dropped and counted too (getDroppedRealtimeEntries()).
+ *
+ * Usage:
+ *   Logger::getInstance()->prepareRealtimeThread();
+ *   while (running)
+ *   {
+ *       LOG_CPP_REALTIME(DEBUG1, "cycle ", cycle, " jitter=", jitterUs, "us");
+ *   }
+ *
+ * Arguments: integers, bool, char, float/double, pointers and strings.
+ * Strings are copied, so they need not outlive the call. An entry's
+ * arguments take at most LOG4CPP_REALTIME_PAYLOAD_CAPACITY bytes; text past
+ * that is cut.
+ */
+
+// Bytes of encoded arguments per entry
+#define LOG4CPP_REALTIME_PAYLOAD_CAPACITY 256
+
+// Tag byte in front of every encoded argument
+enum LogRealtimeTag : uint8_t
+{
+    REALTIME_INT,     // int64_t
+    REALTIME_UINT,    // uint64_t
+    REALTIME_DOUBLE,  // double
+    REALTIME_BOOL,    // uint8_t
+    REALTIME_CHAR,    // char
+    REALTIME_POINTER, // uintptr_t
+    REALTIME_STRING   // uint16_t length, then the characters
+};
+
+// Encodes arguments into a fixed buffer; what does not fit is left out
+class LogRealtimeEncoder
+{
+public:
+    LogRealtimeEncoder(char *buffer, size_t capacity) : data(buffer), used(0), capacity(capacity) {}
+
+    void put(const char *value)
+    {
+        if (value == nullptr)
+        {
+            value = "(null)";
+        }
+        if (capacity - used < 1 + sizeof(uint16_t))
+        {
+            return;
+        }
+        // Copied while scanning, so no more than fits is ever read
+        char *text = data + used + 1 + sizeof(uint16_t);
+        size_t room = capacity - used - 1 - sizeof(uint16_t);
+        uint16_t stored = 0;
+        while (stored < room && value[stored] != '\0')
+        {
+            text[stored] = value[stored];
+            ++stored;
+        }
+        data[used] = static_cast<char>(REALTIME_STRING);
+        std::memcpy(data + used + 1, &stored, sizeof(stored));
+        used += 1 + sizeof(uint16_t) + stored;
+    }
+
+    void put(char *value) { put(static_cast<const char *>(value)); }
+
+    void put(char value) { putValue(REALTIME_CHAR, value); }
+
+    // Printed as characters, like the stream macros do
+    void put(signed char value) { putValue(REALTIME_CHAR, static_cast<char>(value)); }
+    void put(unsigned char value) { putValue(REALTIME_CHAR, static_cast<char>(value)); }
+
+    void put(bool value) { putValue(REALTIME_BOOL, static_cast<uint8_t>(value)); }
+
+    void put(double value) { putValue(REALTIME_DOUBLE, value); }
+
+    void put(float value) { putValue(REALTIME_DOUBLE, static_cast<double>(value)); }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type put(T value)
+    {
+        putValue(REALTIME_INT, static_cast<int64_t>(value));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type put(T value)
+    {
+        putValue(REALTIME_UINT, static_cast<uint64_t>(value));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type put(T value)
+    {
+        put(static_cast<typename std::underlying_type<T>::type>(value));
+    }
+
+    void put(const void *value) { putValue(REALTIME_POINTER, reinterpret_cast<uintptr_t>(value)); }
+
+    // Any other pointer type: its address
+    template <typename T>
+    void put(T *value)
+    {
+        put(static_cast<const void *>(value));
+    }
+
+    // std::string and anything else with data() and size()
+    template <typename T>
+    auto put(const T &value) -> decltype(value.data(), value.size(), void())
+    {
+        putString(value.data(), value.size());
+    }
+
+    const char *payload() const { return data; }
+    size_t size() const { return used; }
+
+private:
+    char *data;
+    size_t used;
+    size_t capacity;
+
+    template <typename T>
+    void putValue(LogRealtimeTag tag, const T &value)
+    {
+        if (capacity - used < 1 + sizeof(T))
+        {
+            return;
+        }
+        data[used++] = static_cast<char>(tag);
+        std::memcpy(data + used, &value, sizeof(T));
+        used += sizeof(T);
+    }
+
+    void putString(const char *text, size_t length)
+    {
+        if (capacity - used < 1 + sizeof(uint16_t))
+        {
+            return;
+        }
+        size_t room = capacity - used - 1 - sizeof(uint16_t);
+        uint16_t stored = static_cast<uint16_t>(length < room ? length : room);
+        data[used++] = static_cast<char>(REALTIME_STRING);
+        std::memcpy(data + used, &stored, sizeof(stored));
+        used += sizeof(stored);
+        std::memcpy(data + used, text, stored);
+        used += stored;
+    }
+};
+
+inline void encodeRealtimeArgs(LogRealtimeEncoder &)
+{
+}
+
+template <typename T, typename... Args>
+void encodeRealtimeArgs(LogRealtimeEncoder &out, const T &arg, const Args &...args)
+{
+    out.put(arg);
+    encodeRealtimeArgs(out, args...);
+}
+
+template <typename... Args>
+void logRealtime(LogLevel level, const LogSourceLocation &location, const Args &...args)
+{
+    Logger *logger = Logger::getInstance();
+    if (!logger->isEnabled(level))
+    {
+        return;
+    }
+    char buffer[LOG4CPP_REALTIME_PAYLOAD_CAPACITY];
+    LogRealtimeEncoder encoder(buffer, sizeof(buffer));
+    encodeRealtimeArgs(encoder, args...);
+    logger->writeRealtime(level, location, encoder.payload(), encoder.size());
+}
+
+// Log from a real-time thread: LOG_CPP_REALTIME(DEBUG1, "cycle ", cycle)
+#define LOG_CPP_REALTIME(level, ...) logRealtime(LogLevel::level, LOG_CPP_SOURCE_LOCATION, __VA_ARGS__)
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/**
+ * LogRedactor - Masks secrets in log messages before any handler sees them
+ *
+ * All patterns are compiled into one Aho-Corasick automaton (a full DFA), so
+ * a message is scanned once however many patterns there are. Stretches of
+ * text that cannot start a match are skipped 16 bytes at a time with SSE2
+ * compares against the patterns' first bytes.
+ *
+ * Pattern kinds:
+ * - Literal: the text itself is masked (e.g. a known API key)
+ * - Key/value: the value after the key is masked, up to whitespace or one of
+ *   & , ; " ' ) ] } < > (e.g. "password=")
+ * - Token: the token characters (letters, digits, - _ . / + =) after the
+ *   prefix are masked (e.g. "ghp_", "sk_live_", "Bearer ")
+ * - Card numbers: runs of 13-19 digits, optionally grouped by single spaces
+ *   or dashes, that pass the Luhn check; all but the last four digits are
+ *   masked
+ *
+ * Masking replaces bytes in place, so the message keeps its length.
+ *
+ * Usage:
+ *   auto redactor = std::make_shared<LogRedactor>();
+ *   redactor->addKeyValue("password=");
+ *   redactor->addToken("Bearer ");
+ *   redactor->addCardNumbers();
+ *   redactor->compile();
+ *   Logger::getInstance()->setRedactor(redactor);
+ */
+class LogRedactor
+{
+public:
+    explicit LogRedactor(bool ignoreCase = false, char mask = '*');
+    ~LogRedactor();
+
+    LogRedactor(const LogRedactor &) = delete;
+    LogRedactor &operator=(const LogRedactor &) = delete;
+
+    // Add patterns; they take effect at the next compile()
+    void addLiteral(const std::string &literal);
+    void addKeyValue(const std::string &key);
+    void addToken(const std::string &prefix);
+    void addCardNumbers();
+
+    // Build the matcher. Not thread-safe; call before sharing the redactor.
+    void compile();
+
+    // Mask all matches in text; returns the number of matches masked.
+    // Thread-safe once compiled.
+    size_t redact(char *text, size_t length) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl;
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "Logger.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Async-signal-safe logging - for use inside signal handlers
+ *
+ * LOG_CPP_SIGNAL_SAFE formats its arguments into a fixed buffer on the
+ * stack and hands the text to Logger::writeSignalSafe(), which copies it
+ * into a preallocated lock-free queue. Nothing on this path takes a lock,
+ * allocates or calls a non-reentrant function (the timestamp is read with
+ * clock_gettime() and converted to local time later). The handlers see the
+ * entry when the queue is next drained: by the backend thread in
+ * asynchronous mode, otherwise by the next log call or flush(), and at
+ * the latest when the process exits normally.
+ *
+ * Usage:
+ *   void onSigterm(int signal)
+ *   {
+ *       LOG_CPP_SIGNAL_SAFE(WARN, "caught signal ", signal, ", shutting down");
+ *       stopRequested = 1;
+ *   }
+ *
+ * Arguments: C strings, char, bool, integers, pointers (hex) and floating
+ * point (fixed, six decimals). Messages are cut at
+ * LOG4CPP_SIGNAL_MESSAGE_CAPACITY - 1 characters; if the queue is full the
+ * entry is dropped.
+ */
+
+// Longest message kept by LOG_CPP_SIGNAL_SAFE, including the NUL
+#define LOG4CPP_SIGNAL_MESSAGE_CAPACITY 400
+
+// Appends text to a fixed buffer without allocating; output beyond the
+// capacity is cut
+class LogSignalSafeFormatter
+{
+public:
+    LogSignalSafeFormatter(char *buffer, size_t capacity) : text(buffer), size(0), capacity(capacity - 1)
+    {
+        text[0] = '\0';
+    }
+
+    LogSignalSafeFormatter &operator<<(const char *value)
+    {
+        if (value == nullptr)
+        {
+            return *this << "(null)";
+        }
+        while (*value != '\0' && size < capacity)
+        {
+            text[size++] = *value++;
+        }
+        text[size] = '\0';
+        return *this;
+    }
+
+    LogSignalSafeFormatter &operator<<(char value)
+    {
+        char pair[2] = {value, '\0'};
+        return *this << pair;
+    }
+
+    LogSignalSafeFormatter &operator<<(bool value) { return *this << (value ? "true" : "false"); }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, LogSignalSafeFormatter &>::type
+    operator<<(T value)
+    {
+        unsigned long long magnitude = static_cast<unsigned long long>(value);
+        if (value < 0)
+        {
+            *this << '-';
+            magnitude = 0 - magnitude;
+        }
+        return appendUnsigned(magnitude, 10, 0);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, LogSignalSafeFormatter &>::type
+    operator<<(T value)
+    {
+        return appendUnsigned(value, 10, 0);
+    }
+
+    LogSignalSafeFormatter &operator<<(const void *value)
+    {
+        *this << "0x";
+        return appendUnsigned(reinterpret_cast<uintptr_t>(value), 16, 0);
+    }
+
+    LogSignalSafeFormatter &operator<<(double value)
+    {
+        if (value != value)
+        {
+            return *this << "nan";
+        }
+        if (value < 0)
+        {
+            *this << '-';
+            value = -value;
+        }
+        if (value >= 1e19)
+        {
+            return *this << "inf";
+        }
+        unsigned long long whole = static_cast<unsigned long long>(value);
+        unsigned long long micros = static_cast<unsigned long long>((value - static_cast<double>(whole)) * 1e6 + 0.5);
+        if (micros >= 1000000)
+        {
+            whole += 1;
+            micros -= 1000000;
+        }
+        appendUnsigned(whole, 10, 0);
+        *this << '.';
+        return appendUnsigned(micros, 10, 6);
+    }
+
+    LogSignalSafeFormatter &operator<<(float value) { return *this << static_cast<double>(value); }
+
+    LogStringRef str() const { return LogStringRef(text, size); }
+
+private:
+    char *text;
+    size_t size;
+    size_t capacity;
+
+    LogSignalSafeFormatter &appendUnsigned(unsigned long long value, unsigned base, int minDigits)
+    {
+        char digits[24];
+        int count = 0;
+        do
+        {
+            digits[count++] = "0123456789abcdef"[value % base];
+            value /= base;
+        } while (value != 0);
+        for (int padding = minDigits - count; padding > 0 && size < capacity; --padding)
+        {
+            text[size++] = '0';
+        }
+        while (count > 0 && size < capacity)
+        {
+            text[size++] = digits[--count];
+        }
+        text[size] = '\0';
+        return *this;
+    }
+};
+
+inline void formatSignalSafeArgs(LogSignalSafeFormatter &)
+{
+}
+
+template <typename T, typename... Args>
+void formatSignalSafeArgs(LogSignalSafeFormatter &out, const T &arg, const Args &...args)
+{
+    out << arg;
+    formatSignalSafeArgs(out, args...);
+}
+
+template <typename... Args>
+void logSignalSafe(LogLevel level, const LogSourceLocation &location, const Args &...args)
+{
+    char buffer[LOG4CPP_SIGNAL_MESSAGE_CAPACITY];
+    LogSignalSafeFormatter formatter(buffer, sizeof(buffer));
+    formatSignalSafeArgs(formatter, args...);
+    Logger::writeSignalSafe(level, location, formatter.str());
+}
+
+// Log from a signal handler: LOG_CPP_SIGNAL_SAFE(WARN, "caught signal ", signal)
+#define LOG_CPP_SIGNAL_SAFE(level, ...) logSignalSafe(LogLevel::level, LOG_CPP_SOURCE_LOCATION, __VA_ARGS__)
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Logger.hpp"
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * Scoped timing spans - cheap, always-available profiling
+ *
+ * LOG_CPP_SPAN("parse") reads the time stamp counter when the scope is
+ * entered and again when it is left. The pair is then queued like any other
+ * record. The backend turns it into an entry whose message reads
+ * "parse took 12.345us" and whose fields are span (the name) and
+ * durationNs. The entry's timestamp is the start of the span.
+ * ChromeTraceHandler writes these entries as trace events for Perfetto or
+ * chrome://tracing.
+ *
+ * Usage:
+ *   void parse(const Request &request)
+ *   {
+ *       LOG_CPP_SPAN("parse");
+ *       ...
+ *   }
+ *
+ * Spans are logged at DEBUG1 (LOG_CPP_SPAN_AT picks the level). Below the
+ * threshold a span costs one level check and reads no counter. The name
+ * must be a string literal.
+ */
+
+// Time stamp counter (cycles) where available, otherwise steady-clock nanoseconds
+inline uint64_t logReadTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+#endif
+}
+
+class LogSpan
+{
+public:
+    LogSpan(LogLevel level, const char *name, const LogSourceLocation &location)
+        : logger(Logger::getInstance()), name(name), location(location), level(level),
+          active(logger->isEnabled(level)), beginTicks(active ? logReadTicks() : 0)
+    {
+    }
+
+    ~LogSpan()
+    {
+        if (active)
+        {
+            logger->writeSpan(level, location, name, beginTicks, logReadTicks());
+        }
+    }
+
+    LogSpan(const LogSpan &) = delete;
+    LogSpan &operator=(const LogSpan &) = delete;
+
+private:
+    Logger *logger;
+    const char *name;
+    LogSourceLocation location;
+    LogLevel level;
+    bool active;
+    uint64_t beginTicks;
+};
+
+#define LOG4CPP_SPAN_CONCAT_(a, b) a##b
+#define LOG4CPP_SPAN_VARIABLE_(line) LOG4CPP_SPAN_CONCAT_(logSpan, line)
+
+// Time the rest of the enclosing scope: LOG_CPP_SPAN("parse")
+#define LOG_CPP_SPAN(name) LOG_CPP_SPAN_AT(DEBUG1, name)
+
+// Same, at a chosen level: LOG_CPP_SPAN_AT(INFO, "request")
+#define LOG_CPP_SPAN_AT(level, name) \
+    LogSpan LOG4CPP_SPAN_VARIABLE_(__LINE__)(LogLevel::level, "" name "", LOG_CPP_SOURCE_LOCATION)
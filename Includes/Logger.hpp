@@ -4,6 +4,17 @@
 #include <memory>
 #include <functional>
 #include <sstream>
+#include <ostream>
+#include <streambuf>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "LogMemoryResource.hpp"
+
+// Longest thread name kept by Logger::setThreadName(), including the NUL
+#define LOG4CPP_THREAD_NAME_CAPACITY 64
 
 enum class LogLevel
 {
@@ -16,20 +27,361 @@ enum class LogLevel
     ERROR
 };
 
-// Structure to hold individual log fields
+// Width every level name is padded to in the default layouts
+#define LOG4CPP_LEVEL_WIDTH 6
+
+/**
+ * LogLevelInfo - Precomputed representations of one log level
+ *
+ * Layouts copy these bytes directly instead of padding or coloring the
+ * name for every line.
+ */
+struct LogLevelInfo
+{
+    const char *name;       // "INFO"
+    size_t nameLength;
+    const char *padded;     // "INFO  ", LOG4CPP_LEVEL_WIDTH characters
+    const char *colored;    // Padded name wrapped in ANSI color codes
+    size_t coloredLength;
+    int syslogSeverity;     // RFC 5424 severity (3 = error ... 7 = debug)
+};
+
+#define LOG4CPP_LEVEL_INFO(name, padded, color, severity) \
+    {name, sizeof(name) - 1, padded, color padded "\033[0m", sizeof(color padded "\033[0m") - 1, severity}
+
+// Table indexed by LogLevel. A class template so the definition can live in
+// the header without breaking the one-definition rule.
+template <typename Unused = void>
+struct LogLevelTable
+{
+    static constexpr LogLevelInfo entries[] = {
+        LOG4CPP_LEVEL_INFO("TRACE", "TRACE ", "\033[90m", 7),
+        LOG4CPP_LEVEL_INFO("DEBUG3", "DEBUG3", "\033[36m", 7),
+        LOG4CPP_LEVEL_INFO("DEBUG2", "DEBUG2", "\033[36m", 7),
+        LOG4CPP_LEVEL_INFO("DEBUG1", "DEBUG1", "\033[36m", 7),
+        LOG4CPP_LEVEL_INFO("INFO", "INFO  ", "\033[32m", 6),
+        LOG4CPP_LEVEL_INFO("WARN", "WARN  ", "\033[33m", 4),
+        LOG4CPP_LEVEL_INFO("ERROR", "ERROR ", "\033[31m", 3)};
+};
+
+template <typename Unused>
+constexpr LogLevelInfo LogLevelTable<Unused>::entries[];
+
+#undef LOG4CPP_LEVEL_INFO
+
+constexpr const LogLevelInfo &logLevelInfo(LogLevel level)
+{
+    return LogLevelTable<>::entries[static_cast<size_t>(level)];
+}
+
+/**
+ * LogStringRef - Non-owning reference to NUL-terminated text
+ *
+ * Used by LogEntry for text the logger already holds (e.g. the formatted
+ * message), so large payloads reach the handlers without being copied.
+ * The referenced text is only valid for the duration of the handler call;
+ * use str() to keep a copy.
+ */
+class LogStringRef
+{
+public:
+    LogStringRef() : text(""), textLength(0) {}
+    LogStringRef(const char *str, size_t length) : text(str), textLength(length) {}
+    LogStringRef(const char *str) : text(str), textLength(std::strlen(str)) {}
+    LogStringRef(const std::string &str) : text(str.c_str()), textLength(str.size()) {}
+
+    const char *data() const { return text; }
+    const char *c_str() const { return text; }
+    size_t size() const { return textLength; }
+    size_t length() const { return textLength; }
+    bool empty() const { return textLength == 0; }
+    const char *begin() const { return text; }
+    const char *end() const { return text + textLength; }
+    char operator[](size_t pos) const { return text[pos]; }
+
+    std::string str() const { return std::string(text, textLength); }
+    std::string substr(size_t pos, size_t count = std::string::npos) const { return str().substr(pos, count); }
+    operator std::string() const { return str(); }
+
+private:
+    const char *text;
+    size_t textLength;
+};
+
+inline bool operator==(const LogStringRef &lhs, const LogStringRef &rhs)
+{
+    return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+inline bool operator!=(const LogStringRef &lhs, const LogStringRef &rhs)
+{
+    return !(lhs == rhs);
+}
+
+inline std::ostream &operator<<(std::ostream &os, const LogStringRef &ref)
+{
+    return os.write(ref.data(), static_cast<std::streamsize>(ref.size()));
+}
+
+inline std::string operator+(const std::string &lhs, const LogStringRef &rhs)
+{
+    return std::string(lhs).append(rhs.data(), rhs.size());
+}
+
+inline std::string operator+(const LogStringRef &lhs, const std::string &rhs)
+{
+    return lhs.str() + rhs;
+}
+
+inline std::string operator+(const char *lhs, const LogStringRef &rhs)
+{
+    return std::string(lhs).append(rhs.data(), rhs.size());
+}
+
+inline std::string operator+(const LogStringRef &lhs, const char *rhs)
+{
+    return lhs.str().append(rhs);
+}
+
+inline std::string operator+(const LogStringRef &lhs, const LogStringRef &rhs)
+{
+    return lhs.str().append(rhs.data(), rhs.size());
+}
+
+/**
+ * LogSourceLocation - Call site captured by the LOG_CPP_* macros
+ *
+ * Built only from compile-time constants (string literals, __FUNCTION__ and
+ * the file basename computed by logBasenameOffset()), so passing it costs no
+ * std::string construction, and the logger keeps the pointers instead of
+ * copying the text.
+ */
+struct LogSourceLocation
+{
+    const char *file; // Basename of the source file
+    const char *function;
+    size_t functionLength;
+    int line;
+};
+
+// Offset of the file name within a path; used in constant expressions so
+// the basename is found at compile time
+constexpr size_t logBasenameOffset(const char *path)
+{
+    size_t offset = 0;
+    for (size_t i = 0; path[i] != '\0'; ++i)
+    {
+        if (path[i] == '/' || path[i] == '\\')
+        {
+            offset = i + 1;
+        }
+    }
+    return offset;
+}
+
+// Type of a LogField value
+enum class LogFieldType : uint8_t
+{
+    INT,
+    UINT,
+    DOUBLE,
+    BOOL,
+    STRING
+};
+
+// Typed key/value pair attached to a LogEntry (e.g. by structured encoders)
+struct LogField
+{
+    LogStringRef key;
+    LogFieldType type;
+    union
+    {
+        int64_t intValue;
+        uint64_t uintValue;
+        double doubleValue;
+        bool boolValue;
+    };
+    LogStringRef stringValue; // Only for LogFieldType::STRING
+};
+
+// Structure to hold individual log fields. The text fields reference storage
+// owned by the logger and are only valid during the handler call.
 struct LogEntry
 {
-    std::string timestamp;
-    std::string level;
-    std::string component;
-    std::string function;
+    LogStringRef timestamp;
+    LogStringRef level;
+    LogStringRef component;
+    LogStringRef function;
     int lineNumber;
-    std::string message;
+    LogStringRef message;
+    uint64_t threadId;       // Kernel thread id, cached per thread
+    LogStringRef threadName; // Name from Logger::setThreadName(), else the thread id
+    int processId;           // Cached, refreshed after fork()
+    LogStringRef file;       // Source file basename (empty for the legacy function/line API)
+    LogLevel severity;       // Same level as an enum, e.g. to index logLevelInfo()
+    int64_t timestampNs;     // Nanoseconds since the epoch, the source of timestamp
+    const LogField *fields;  // Structured fields, nullptr if none
+    size_t fieldCount;
+};
+
+/**
+ * LogStreamBuffer - Growable stream buffer the message is formatted into
+ *
+ * Unlike std::ostringstream, the formatted text can be read in place
+ * (always NUL-terminated) instead of being copied out with str().
+ * Messages that outgrow the inline storage are moved to memory from the
+ * active LogMemoryResource. If that allocation fails the message is
+ * truncated (ending in "...") instead of lost.
+ */
+class LogStreamBuffer : public std::streambuf
+{
+public:
+    LogStreamBuffer();
+    ~LogStreamBuffer() override;
+
+    LogStreamBuffer(const LogStreamBuffer &) = delete;
+    LogStreamBuffer &operator=(const LogStreamBuffer &) = delete;
+
+    LogStringRef text();
+
+    // Rewind to an empty message, keeping the allocated storage unless it is
+    // oversized or came from a resource that is no longer active
+    void reset();
+
+    // Return grown storage to its resource and fall back to inline storage
+    void releaseStorage();
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char *s, std::streamsize count) override;
+
+private:
+    char *storage;
+    size_t storageSize;
+    LogMemoryResource *storageResource;
+    char inlineStorage[256];
+
+    bool truncated;
+
+    bool grow(size_t required);
+    void advance(size_t count);
+};
+
+// Output stream writing into a LogStreamBuffer
+class LogStream : public std::ostream
+{
+public:
+    LogStream() : std::ostream(nullptr) { rdbuf(&buffer); }
+
+    LogStringRef text() { return buffer.text(); }
+
+    // Rewind to an empty message with default formatting flags
+    void reset();
+
+    // Free storage grown from a memory resource
+    void releaseStorage() { buffer.releaseStorage(); }
+
+    // Borrows the calling thread's reusable stream so formatting a message
+    // does not allocate; a private stream is used if the thread's stream is
+    // already busy (an argument's operator<< that logs itself)
+    class Lease;
+
+private:
+    LogStreamBuffer buffer;
+};
+
+class LogStream::Lease
+{
+public:
+    Lease();
+    ~Lease();
+
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+
+    LogStream &get() { return *stream; }
+
+private:
+    LogStream *stream;
+    std::unique_ptr<LogStream> owned;
+};
+
+// Options for asynchronous logging (see Logger::startAsync)
+struct AsyncLogOptions
+{
+    size_t slabSize = 1024 * 1024; // Per-thread record slab, rounded up to a power of two
+    bool hugePages = false;        // Back slabs with huge pages when available
+    bool prefault = false;         // Fault slab pages in up front instead of on first use
+    std::string spillPath;         // If set, records that find their slab full go to this file instead of
+                                   // waiting; replayed in order, also by the next process after a crash
+
+    // NUMA machines; both are ignored where the system reports one node.
+    // numaLocal places each thread's slab on the node the thread first logs
+    // from. backendPerNode runs one backend per node, pinned to it, each
+    // draining its node's slabs (this implies numaLocal); handlers still see
+    // one entry at a time, but entries from different nodes are no longer
+    // merged strictly by timestamp.
+    bool numaLocal = false;
+    bool backendPerNode = false;
+
+    // Adaptive verbosity: while the backend falls behind, entries below
+    // pressureLevel are filtered out at the call site (TRACE, the default,
+    // turns this off). Pressure starts when a drain finds a slab at least
+    // pressureHighWatermark full, or the handlers take pressureLatencyUs or
+    // more per entry (0 = not used); it ends once a drain finds every slab at
+    // most pressureLowWatermark full and entries are written faster than
+    // that. Each change is logged as one notice line.
+    LogLevel pressureLevel = LogLevel::TRACE;
+    double pressureHighWatermark = 0.5;
+    double pressureLowWatermark = 0.1;
+    uint32_t pressureLatencyUs = 0;
+};
+
+// Startup work for Logger::initialize, so the first messages after startup
+// cost what later ones do instead of paying lazy first-use costs
+struct LogWarmupOptions
+{
+    bool loadTimezone = true;      // Load the time zone data (tzset) now rather than at the first timestamp
+    bool warmCallingThread = true; // Call Logger::warmThread() for the initializing thread
+    bool prefault = true;          // Prefault every record slab, as AsyncLogOptions::prefault
+    bool lockMemory = false;       // Also lock record slabs in RAM (mlock, subject to RLIMIT_MEMLOCK)
 };
 
 // Output handler interface
 using OutputHandler = std::function<void(const LogEntry &)>;
 
+// Fallback for an output handler that ran out of memory: gets the entry
+// already laid out as one line (newline included) in a preallocated buffer,
+// and must write it without allocating
+using EmergencyHandler = std::function<void(const LogEntry &entry, LogStringRef line)>;
+
+class LogRedactor;
+
+// Field layout of an event declared with LOG4CPP_EVENT (see LogEvent.hpp)
+struct LogEventSchema;
+
+// How a handler is called (see Logger::setHandlerWatchdog())
+enum class LogHandlerState
+{
+    DIRECT,   // By the logging thread or the backend, in turn with the others
+    ISOLATED, // By a thread of its own, from a bounded queue
+    DISABLED  // Not at all
+};
+
+// Per-handler counters from Logger::getHandlerStats()
+struct LogHandlerStats
+{
+    LogHandlerState state;
+    uint64_t calls;     // Entries passed to the handler
+    uint64_t slowestNs; // Longest single call (measured while the watchdog is on)
+    size_t queued;      // Entries waiting for an isolated handler
+    uint64_t dropped;   // Entries an isolated handler missed because its queue was full
+};
+
+// Called after the last entry of a batch: after every synchronous write, and
+// after each drain cycle of the asynchronous backend
+using FlushHandler = std::function<void()>;
+
 /**
  * Logger - Thread-safe singleton logging system with customizable handlers
  *
@@ -44,79 +396,324 @@ public:
     // Singleton getter (thread-safe with double-checked locking)
     static Logger *getInstance();
 
-    // Initialize singleton with component name and log level (thread-safe)
-    static void initialize(const std::string &name, LogLevel level = LogLevel::INFO);
+    // Initialize singleton with component name, log level and optionally the
+    // memory resource for formatting buffers and record slabs (thread-safe).
+    // A child of fork() calls it again before logging: the logger it
+    // inherited is replaced, since its locks may have been held by threads
+    // the child does not have.
+    static void initialize(const std::string &name, LogLevel level = LogLevel::INFO,
+                           LogMemoryResource *resource = nullptr);
+
+    // Same, doing the startup work in `warmup` before the logger is used
+    static void initialize(const std::string &name, LogLevel level, LogMemoryResource *resource,
+                           const LogWarmupOptions &warmup);
 
     // Register a custom output handler (thread-safe)
     void registerHandler(OutputHandler handler);
 
+    // Register a handler with its out-of-memory fallback (thread-safe). An
+    // entry a handler could not write because std::bad_alloc was thrown goes
+    // to its emergency handler, or to stderr if it has none.
+    void registerHandler(OutputHandler handler, EmergencyHandler emergency);
+
+    // Register a handler that receives messages unsanitized, e.g. a binary
+    // sink that stores them length-prefixed (thread-safe)
+    void registerRawHandler(OutputHandler handler, EmergencyHandler emergency = EmergencyHandler());
+
     // Clear all handlers (thread-safe)
     void clearHandlers();
 
     // Replace all handlers with a new one (thread-safe)
     void setHandler(OutputHandler handler);
 
+    // Register a batch-end callback for a buffering handler (thread-safe).
+    // clearHandlers() and setHandler() call and remove the flush handlers.
+    void registerFlushHandler(FlushHandler handler);
+
+    // Register a callback that finishes a handler's output, e.g. writes a
+    // trailer (thread-safe). Called once, after the flush handlers, when
+    // clearHandlers() or setHandler() removes the handlers or at exit.
+    void registerCloseHandler(FlushHandler handler);
+
+    // Mask secrets in every message and string field once, before any
+    // handler sees them (thread-safe; nullptr turns redaction off). The
+    // redactor must be compiled; it is kept alive by the logger.
+    void setRedactor(std::shared_ptr<const LogRedactor> redactor);
+
+    // Escape line breaks and control bytes and replace invalid UTF-8 in
+    // messages before dispatch (off by default; thread-safe). Handlers
+    // registered with registerRawHandler() still get the original text.
+    void setSanitization(bool enabled);
+
+    // Watchdog for handlers that block (a hung network mount, a full pipe):
+    // a handler whose call takes thresholdUs or longer is moved to a thread
+    // of its own with a bounded queue, or, if isolate is false, no longer
+    // called; either way a warning goes to stderr. 0 (the default) turns
+    // the watchdog off. An isolated handler runs concurrently with the
+    // others and with the flush handlers, and flush() does not wait for it;
+    // stopAsync() and exit write out its queue and join its thread.
+    void setHandlerWatchdog(uint32_t thresholdUs, bool isolate = true);
+
+    // Counters of the registered handlers, in registration order
+    std::vector<LogHandlerStats> getHandlerStats() const;
+
     // Set log level threshold
     void setLogLevel(LogLevel level);
 
     // Get current log level
     LogLevel getLogLevel() const;
 
-    // Template logging methods
+    // Threshold in effect: the log level, or AsyncLogOptions::pressureLevel
+    // while the backend is falling behind
+    LogLevel getEffectiveLogLevel() const;
+
+    // True if messages at `level` pass the threshold (checked before formatting)
+    bool isEnabled(LogLevel level) const;
+
+    // Queue records in per-thread slabs and call the handlers from a backend
+    // thread instead of the logging thread
+    void startAsync(const AsyncLogOptions &options = AsyncLogOptions());
+
+    // Drain queued records, stop the backend thread and log synchronously again
+    void stopAsync();
+
+    // Block until every record queued so far has been passed to the handlers
+    void flush();
+
+    // Logger-wide memory resource for message buffers and record slabs
+    // (nullptr restores operator new/delete). Set it before logging starts;
+    // the resource must be thread-safe and outlive the logger.
+    void setMemoryResource(LogMemoryResource *resource);
+
+    // Get the logger-wide memory resource
+    LogMemoryResource *getMemoryResource() const;
+
+    // Name the calling thread (truncated to LOG4CPP_THREAD_NAME_CAPACITY - 1
+    // characters); an empty name reverts to the numeric thread id
+    static void setThreadName(const std::string &name);
+
+    // Pay the calling thread's first-log costs now: its cached identity, the
+    // timestamp cache, its formatting stream and, in asynchronous mode, its
+    // record slab. Call it once from each thread before latency matters.
+    void warmThread();
+
+    // Color the level in defaultConsoleHandler with ANSI escapes (off by default)
+    static void setConsoleColors(bool enabled);
+
+    // Memory resource for the calling thread only, e.g. a per-request arena
+    // (nullptr reverts to the logger-wide one). Memory from the previous
+    // resource is no longer referenced once this returns.
+    static void setThreadMemoryResource(LogMemoryResource *resource);
+
+    // Queue an entry from a signal handler (async-signal-safe): no locks, no
+    // allocation, no localtime(). The handlers get it at the next drain; see
+    // LOG_CPP_SIGNAL_SAFE in LogSignalSafe.hpp. Does nothing before
+    // initialize()/getInstance() or when the queue is full.
+    static void writeSignalSafe(LogLevel level, const LogSourceLocation &location, LogStringRef message) noexcept;
+
+    // Signal-safe entries dropped because their queue was full
+    uint64_t getDroppedSignalSafeEntries() const;
+
+    // Set up the calling thread for LOG_CPP_REALTIME (see LogRealtime.hpp):
+    // allocates its record slab and caches its identity, so later calls
+    // neither allocate nor enter the kernel
+    void prepareRealtimeThread();
+
+    // Queue a LOG_CPP_REALTIME entry (encoded arguments) without locking,
+    // allocating or waiting; dropped if that is not possible
+    void writeRealtime(LogLevel level, const LogSourceLocation &location, const char *payload, size_t size) noexcept;
+
+    // Real-time entries dropped: slab full, thread not prepared or
+    // asynchronous mode off
+    uint64_t getDroppedRealtimeEntries() const;
+
+    // Record a finished LOG_CPP_SPAN (see LogSpan.hpp). The ticks come from
+    // logReadTicks(); the name must be a static string.
+    void writeSpan(LogLevel level, const LogSourceLocation &location, const char *name, uint64_t beginTicks,
+                   uint64_t endTicks);
+
+    // Template logging methods. The LOG_CPP_* macros pass a LogSourceLocation;
+    // the (function, lineNumber) overloads are kept for direct callers and
+    // copy the function name.
+    template <typename... Args>
+    void trace(const LogSourceLocation &location, const Args &...args)
+    {
+        if (!isEnabled(LogLevel::TRACE))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::TRACE, location, stream.get().text());
+    }
+
     template <typename... Args>
     void trace(const std::string &function, int lineNumber, const Args &...args)
     {
-        std::ostringstream oss;
-        formatArgs(oss, args...);
-        writeLog(LogLevel::TRACE, function, lineNumber, oss.str());
+        if (!isEnabled(LogLevel::TRACE))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::TRACE, function, lineNumber, stream.get().text());
+    }
+
+    template <typename... Args>
+    void debug3(const LogSourceLocation &location, const Args &...args)
+    {
+        if (!isEnabled(LogLevel::DEBUG3))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::DEBUG3, location, stream.get().text());
     }
 
     template <typename... Args>
     void debug3(const std::string &function, int lineNumber, const Args &...args)
     {
-        std::ostringstream oss;
-        formatArgs(oss, args...);
-        writeLog(LogLevel::DEBUG3, function, lineNumber, oss.str());
+        if (!isEnabled(LogLevel::DEBUG3))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::DEBUG3, function, lineNumber, stream.get().text());
+    }
+
+    template <typename... Args>
+    void debug2(const LogSourceLocation &location, const Args &...args)
+    {
+        if (!isEnabled(LogLevel::DEBUG2))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::DEBUG2, location, stream.get().text());
     }
 
     template <typename... Args>
     void debug2(const std::string &function, int lineNumber, const Args &...args)
     {
-        std::ostringstream oss;
-        formatArgs(oss, args...);
-        writeLog(LogLevel::DEBUG2, function, lineNumber, oss.str());
+        if (!isEnabled(LogLevel::DEBUG2))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::DEBUG2, function, lineNumber, stream.get().text());
+    }
+
+    template <typename... Args>
+    void debug1(const LogSourceLocation &location, const Args &...args)
+    {
+        if (!isEnabled(LogLevel::DEBUG1))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::DEBUG1, location, stream.get().text());
     }
 
     template <typename... Args>
     void debug1(const std::string &function, int lineNumber, const Args &...args)
     {
-        std::ostringstream oss;
-        formatArgs(oss, args...);
-        writeLog(LogLevel::DEBUG1, function, lineNumber, oss.str());
+        if (!isEnabled(LogLevel::DEBUG1))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::DEBUG1, function, lineNumber, stream.get().text());
+    }
+
+    template <typename... Args>
+    void info(const LogSourceLocation &location, const Args &...args)
+    {
+        if (!isEnabled(LogLevel::INFO))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::INFO, location, stream.get().text());
     }
 
     template <typename... Args>
     void info(const std::string &function, int lineNumber, const Args &...args)
     {
-        std::ostringstream oss;
-        formatArgs(oss, args...);
-        writeLog(LogLevel::INFO, function, lineNumber, oss.str());
+        if (!isEnabled(LogLevel::INFO))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::INFO, function, lineNumber, stream.get().text());
+    }
+
+    template <typename... Args>
+    void warn(const LogSourceLocation &location, const Args &...args)
+    {
+        if (!isEnabled(LogLevel::WARN))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::WARN, location, stream.get().text());
     }
 
     template <typename... Args>
     void warn(const std::string &function, int lineNumber, const Args &...args)
     {
-        std::ostringstream oss;
-        formatArgs(oss, args...);
-        writeLog(LogLevel::WARN, function, lineNumber, oss.str());
+        if (!isEnabled(LogLevel::WARN))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::WARN, function, lineNumber, stream.get().text());
+    }
+
+    template <typename... Args>
+    void error(const LogSourceLocation &location, const Args &...args)
+    {
+        if (!isEnabled(LogLevel::ERROR))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::ERROR, location, stream.get().text());
     }
 
     template <typename... Args>
     void error(const std::string &function, int lineNumber, const Args &...args)
     {
-        std::ostringstream oss;
-        formatArgs(oss, args...);
-        writeLog(LogLevel::ERROR, function, lineNumber, oss.str());
+        if (!isEnabled(LogLevel::ERROR))
+        {
+            return;
+        }
+        LogStream::Lease stream;
+        formatArgs(stream.get(), args...);
+        writeLog(LogLevel::ERROR, function, lineNumber, stream.get().text());
+    }
+
+    // Log an event declared with LOG4CPP_EVENT. The event is copied as raw
+    // bytes; its text and fields are rendered from the schema at dispatch.
+    template <typename Event>
+    void event(LogLevel level, const LogSourceLocation &location, const Event &event)
+    {
+        static_assert(std::is_trivially_copyable<Event>::value, "log events must be trivially copyable");
+        if (!isEnabled(level))
+        {
+            return;
+        }
+        writeEvent(level, location, Event::schema(), &event);
     }
 
     // Destructor
@@ -132,35 +729,42 @@ private:
 
     // Helper for variadic templates - forward to impl
     template <typename T>
-    static void formatArg(std::ostringstream &oss, const T &arg)
+    static void formatArg(std::ostream &os, const T &arg)
     {
-        oss << arg;
+        os << arg;
     }
 
     template <typename T, typename... Args>
-    static void formatArgs(std::ostringstream &oss, const T &arg, const Args &...args)
+    static void formatArgs(std::ostream &os, const T &arg, const Args &...args)
     {
-        oss << arg;
-        formatArgs(oss, args...);
+        os << arg;
+        formatArgs(os, args...);
     }
 
-    static void formatArgs(std::ostringstream &)
+    static void formatArgs(std::ostream &)
     {
         // Base case: no more arguments
     }
 
     // Write log entry - forwards to impl
-    void writeLog(LogLevel level, const std::string &function, int lineNumber, const std::string &message);
+    void writeLog(LogLevel level, const LogSourceLocation &location, LogStringRef message);
+    void writeLog(LogLevel level, const std::string &function, int lineNumber, LogStringRef message);
+    void writeEvent(LogLevel level, const LogSourceLocation &location, const LogEventSchema &schema, const void *data);
 
     // Singleton instance
     static Logger *instance;
 };
 
-// Convenience macros for automatic function name and line number
-#define LOG_CPP_TRACE(...) Logger::getInstance()->trace(__FUNCTION__, __LINE__, __VA_ARGS__)
-#define LOG_CPP_DEBUG3(...) Logger::getInstance()->debug3(__FUNCTION__, __LINE__, __VA_ARGS__)
-#define LOG_CPP_DEBUG2(...) Logger::getInstance()->debug2(__FUNCTION__, __LINE__, __VA_ARGS__)
-#define LOG_CPP_DEBUG1(...) Logger::getInstance()->debug1(__FUNCTION__, __LINE__, __VA_ARGS__)
-#define LOG_CPP_INFO(...) Logger::getInstance()->info(__FUNCTION__, __LINE__, __VA_ARGS__)
-#define LOG_CPP_WARN(...) Logger::getInstance()->warn(__FUNCTION__, __LINE__, __VA_ARGS__)
-#define LOG_CPP_ERROR(...) Logger::getInstance()->error(__FUNCTION__, __LINE__, __VA_ARGS__)
+// Call site as a compile-time constant: file basename, function name and line
+#define LOG_CPP_SOURCE_LOCATION                                                               \
+    LogSourceLocation{__FILE__ + std::integral_constant<size_t, logBasenameOffset(__FILE__)>::value, \
+                      __FUNCTION__, sizeof(__FUNCTION__) - 1, __LINE__}
+
+// Convenience macros for automatic source location
+#define LOG_CPP_TRACE(...) Logger::getInstance()->trace(LOG_CPP_SOURCE_LOCATION, __VA_ARGS__)
+#define LOG_CPP_DEBUG3(...) Logger::getInstance()->debug3(LOG_CPP_SOURCE_LOCATION, __VA_ARGS__)
+#define LOG_CPP_DEBUG2(...) Logger::getInstance()->debug2(LOG_CPP_SOURCE_LOCATION, __VA_ARGS__)
+#define LOG_CPP_DEBUG1(...) Logger::getInstance()->debug1(LOG_CPP_SOURCE_LOCATION, __VA_ARGS__)
+#define LOG_CPP_INFO(...) Logger::getInstance()->info(LOG_CPP_SOURCE_LOCATION, __VA_ARGS__)
+#define LOG_CPP_WARN(...) Logger::getInstance()->warn(LOG_CPP_SOURCE_LOCATION, __VA_ARGS__)
+#define LOG_CPP_ERROR(...) Logger::getInstance()->error(LOG_CPP_SOURCE_LOCATION, __VA_ARGS__)
@@ -50,6 +50,24 @@ extern "C"
     // Register a custom C-compatible handler
     void logger_register_handler(CLogHandler handler);
 
+    // Name the calling thread in log entries (NULL or "" reverts to the thread id)
+    void logger_set_thread_name(const char *name);
+
+    // Switch to asynchronous logging (per-thread slabs drained by a backend thread)
+    void logger_start_async(void);
+
+    // Drain queued records and return to synchronous logging
+    void logger_stop_async(void);
+
+    // Block until all queued records have been written
+    void logger_flush(void);
+
+    // Log from a signal handler (async-signal-safe): the message is copied
+    // as is (no printf formatting) into a preallocated queue, cut at 399
+    // characters, and written at the next drain. `function` must be a
+    // string literal such as __FUNCTION__.
+    void logger_signal_safe(CLogLevel level, const char *function, int line, const char *message);
+
     // Logging functions - internal versions with function and line number
     void logger_trace_impl(CLogger logger, const char *function, int line, const char *format, ...);
     void logger_debug3_impl(CLogger logger, const char *function, int line, const char *format, ...);
@@ -68,6 +86,7 @@ extern "C"
 #define LOG_INFO(fmt, ...) logger_info_impl(logger_get_instance(), __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
 #define LOG_WARN(fmt, ...) logger_warn_impl(logger_get_instance(), __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
 #define LOG_ERROR(fmt, ...) logger_error_impl(logger_get_instance(), __FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+#define LOG_SIGNAL_SAFE(level, message) logger_signal_safe(level, __FUNCTION__, __LINE__, message)
 
 #ifdef __cplusplus
 }
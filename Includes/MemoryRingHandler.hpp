@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Logger.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One entry read back from a MemoryRingHandler
+struct LogRingRecord
+{
+    int64_t timestampNs; // Nanoseconds since the epoch
+    LogLevel level;
+    uint64_t threadId;
+    std::string file;
+    std::string function;
+    int lineNumber;
+    std::string message; // Cut to the ring's maxMessageSize
+    bool truncated;      // True if the message was cut
+};
+
+// Filter for MemoryRingHandler::query(); the defaults match everything
+struct LogRingQuery
+{
+    LogLevel minLevel = LogLevel::TRACE;
+    int64_t fromNs = INT64_MIN; // Timestamp range, inclusive
+    int64_t toNs = INT64_MAX;
+    std::string contains;       // Substring of the message
+    std::string site;           // Substring of the file or function name
+    size_t limit = SIZE_MAX;    // Keep only the newest `limit` matches
+};
+
+/**
+ * MemoryRingHandler - Keeps the most recent entries in memory for queries
+ *
+ * Entries are stored as compact fixed-size records: timestamp, level,
+ * thread, call site and the first maxMessageSize bytes of the message. The
+ * ring holds `capacity` records, and its memory is allocated once, up front.
+ * New entries overwrite the oldest.
+ *
+ * query() may run on any thread while logging goes on. Each record carries
+ * a sequence number (seqlock): a reader copies the record and checks that
+ * the number did not change while it copied, so writers never wait for
+ * readers and readers never see half-written records.
+ *
+ * Example:
+ *   MemoryRingHandler *recent = registerMemoryRingHandler(4096);
+ *   ...
+ *   LogRingQuery query;
+ *   query.minLevel = LogLevel::WARN;
+ *   query.limit = 1000;
+ *   for (const LogRingRecord &record : recent->query(query)) ...
+ */
+class MemoryRingHandler
+{
+public:
+    /**
+     * Constructor
+     * @param capacity        Records kept
+     * @param maxMessageSize  Message bytes kept per record; longer messages are cut
+     */
+    explicit MemoryRingHandler(size_t capacity = 4096, size_t maxMessageSize = 256);
+    ~MemoryRingHandler();
+
+    /**
+     * Matching records, oldest first (thread-safe, does not block logging)
+     */
+    std::vector<LogRingRecord> query(const LogRingQuery &query = LogRingQuery()) const;
+
+    /**
+     * Entries written since construction, including overwritten ones
+     */
+    uint64_t getTotalEntries() const;
+
+private:
+    // Pimpl: pointer to implementation
+    class Impl;
+    std::unique_ptr<Impl> impl;
+
+    /**
+     * Handler function - private, use registerMemoryRingHandler() instead
+     */
+    void write(const LogEntry &entry);
+
+    friend MemoryRingHandler *registerMemoryRingHandler(size_t capacity, size_t maxMessageSize);
+};
+
+// Convenience function: register a ring with the logger. The ring lives as
+// long as the process; keep the pointer to query it.
+MemoryRingHandler *registerMemoryRingHandler(size_t capacity = 4096, size_t maxMessageSize = 256);
@@ -0,0 +1,661 @@
+#include "BinaryLogFormat.hpp"
+#include "LogFraming.hpp"
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+// ========== Helpers ==========
+
+static void appendVarint(std::string &out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+static uint64_t zigzagEncode(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t zigzagDecode(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+static void appendFixed64(std::string &out, uint64_t value)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        out += static_cast<char>(value >> (i * 8));
+    }
+}
+
+// ========== BinaryLogEncoder::Impl Definition ==========
+
+class BinaryLogEncoder::Impl
+{
+public:
+    struct SiteKey
+    {
+        uint32_t file;
+        uint32_t function;
+        int line;
+
+        bool operator==(const SiteKey &other) const
+        {
+            return file == other.file && function == other.function && line == other.line;
+        }
+    };
+
+    struct SiteKeyHash
+    {
+        size_t operator()(const SiteKey &key) const
+        {
+            uint64_t hash = (static_cast<uint64_t>(key.file) << 32) ^ key.function;
+            hash = hash * 0x9E3779B97F4A7C15ULL ^ static_cast<uint32_t>(key.line);
+            return static_cast<size_t>(hash * 0x9E3779B97F4A7C15ULL);
+        }
+    };
+
+    bool segmentOpen;
+    int64_t lastTimestampNs;
+    std::unordered_map<std::string, uint32_t> strings;
+    std::unordered_map<SiteKey, uint32_t, SiteKeyHash> sites;
+    std::string lookupKey;           // Reused so known strings are found without allocating
+    std::vector<uint32_t> fieldKeys; // Reused per entry
+
+    Impl() : segmentOpen(false), lastTimestampNs(0) {}
+
+    void beginSegment()
+    {
+        segmentOpen = false;
+        strings.clear();
+        sites.clear();
+    }
+
+    // Id of text in the segment table, defining it first if it is new
+    uint32_t stringId(LogStringRef text, std::string &out)
+    {
+        lookupKey.assign(text.data(), text.size());
+        auto found = strings.find(lookupKey);
+        if (found != strings.end())
+        {
+            return found->second;
+        }
+
+        uint32_t id = static_cast<uint32_t>(strings.size());
+        strings.emplace(lookupKey, id);
+        out += static_cast<char>(BINARY_TAG_STRING);
+        appendVarint(out, text.size());
+        out.append(text.data(), text.size());
+        return id;
+    }
+
+    uint32_t siteId(const LogEntry &entry, std::string &out)
+    {
+        SiteKey key{stringId(entry.file, out), stringId(entry.function, out), entry.lineNumber};
+        auto found = sites.find(key);
+        if (found != sites.end())
+        {
+            return found->second;
+        }
+
+        uint32_t id = static_cast<uint32_t>(sites.size());
+        sites.emplace(key, id);
+        out += static_cast<char>(BINARY_TAG_SITE);
+        appendVarint(out, key.file);
+        appendVarint(out, key.function);
+        appendVarint(out, zigzagEncode(key.line));
+        return id;
+    }
+
+    static void appendFieldValue(const LogField &field, std::string &out)
+    {
+        out += static_cast<char>(field.type);
+        switch (field.type)
+        {
+        case LogFieldType::INT:
+            appendVarint(out, zigzagEncode(field.intValue));
+            break;
+        case LogFieldType::UINT:
+            appendVarint(out, field.uintValue);
+            break;
+        case LogFieldType::DOUBLE:
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &field.doubleValue, sizeof(bits));
+            appendFixed64(out, bits);
+            break;
+        }
+        case LogFieldType::BOOL:
+            out += static_cast<char>(field.boolValue ? 1 : 0);
+            break;
+        case LogFieldType::STRING:
+            appendVarint(out, field.stringValue.size());
+            out.append(field.stringValue.data(), field.stringValue.size());
+            break;
+        }
+    }
+
+    void encode(const LogEntry &entry, std::string &out)
+    {
+        if (!segmentOpen)
+        {
+            out += static_cast<char>(BINARY_TAG_SEGMENT);
+            out.append(LOG4CPP_BINARY_MAGIC, 4);
+            appendVarint(out, LOG4CPP_BINARY_VERSION);
+            appendVarint(out, static_cast<uint64_t>(entry.timestampNs));
+            lastTimestampNs = entry.timestampNs;
+            segmentOpen = true;
+        }
+
+        // Definitions have to precede the entry that refers to them
+        uint32_t site = siteId(entry, out);
+        uint32_t component = stringId(entry.component, out);
+        uint32_t threadName = stringId(entry.threadName, out);
+        fieldKeys.clear();
+        for (size_t i = 0; i < entry.fieldCount; ++i)
+        {
+            fieldKeys.push_back(stringId(entry.fields[i].key, out));
+        }
+
+        out += static_cast<char>(BINARY_TAG_ENTRY);
+        appendVarint(out, static_cast<uint64_t>(entry.severity));
+        appendVarint(out, zigzagEncode(entry.timestampNs - lastTimestampNs));
+        lastTimestampNs = entry.timestampNs;
+        appendVarint(out, site);
+        appendVarint(out, component);
+        appendVarint(out, entry.threadId);
+        appendVarint(out, threadName);
+        appendVarint(out, static_cast<uint64_t>(entry.processId));
+        appendVarint(out, entry.message.size());
+        out.append(entry.message.data(), entry.message.size());
+        appendVarint(out, entry.fieldCount);
+        for (size_t i = 0; i < entry.fieldCount; ++i)
+        {
+            appendVarint(out, fieldKeys[i]);
+            appendFieldValue(entry.fields[i], out);
+        }
+    }
+};
+
+// ========== BinaryLogEncoder Implementation ==========
+
+BinaryLogEncoder::BinaryLogEncoder() : impl(std::make_unique<Impl>())
+{
+}
+
+BinaryLogEncoder::~BinaryLogEncoder() = default;
+
+void BinaryLogEncoder::beginSegment()
+{
+    impl->beginSegment();
+}
+
+void BinaryLogEncoder::encode(const LogEntry &entry, std::string &out)
+{
+    impl->encode(entry, out);
+}
+
+// ========== BinaryLogDecoder::Impl Definition ==========
+
+class BinaryLogDecoder::Impl
+{
+public:
+    struct Site
+    {
+        uint32_t file;
+        uint32_t function;
+        int line;
+    };
+
+    const char *position;
+    const char *end;
+    bool error;
+    bool segmentOpen;
+    int64_t lastTimestampNs;
+
+    // A deque so stored strings never move while entries refer to them
+    std::deque<std::string> strings;
+    std::vector<Site> sites;
+
+    // Storage behind the LogEntry returned by next()
+    char timestampText[32];
+    std::string message;
+    std::vector<LogField> fields;
+    std::vector<std::string> fieldStrings;
+
+    Impl(const char *data, size_t size)
+        : position(data), end(data + size), error(false), segmentOpen(false), lastTimestampNs(0)
+    {
+        timestampText[0] = '\0';
+    }
+
+    bool fail()
+    {
+        error = true;
+        return false;
+    }
+
+    bool readVarint(uint64_t &value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64 && position < end; shift += 7)
+        {
+            uint8_t byte = static_cast<uint8_t>(*position++);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readBytes(size_t length, std::string &out)
+    {
+        if (static_cast<size_t>(end - position) < length)
+        {
+            return false;
+        }
+        out.assign(position, length);
+        position += length;
+        return true;
+    }
+
+    bool readStringId(LogStringRef &out)
+    {
+        uint64_t id;
+        if (!readVarint(id) || id >= strings.size())
+        {
+            return false;
+        }
+        const std::string &text = strings[static_cast<size_t>(id)];
+        out = LogStringRef(text.c_str(), text.size());
+        return true;
+    }
+
+    void formatTimestamp(int64_t timestampNs)
+    {
+        time_t seconds = static_cast<time_t>(timestampNs / 1000000000);
+        long micros = static_cast<long>((timestampNs % 1000000000) / 1000);
+        struct tm local;
+        localtime_r(&seconds, &local);
+        size_t length = std::strftime(timestampText, sizeof(timestampText), "%Y-%m-%d %H:%M:%S", &local);
+        std::snprintf(timestampText + length, sizeof(timestampText) - length, ".%06ld", micros);
+    }
+
+    bool readSegment()
+    {
+        uint64_t version;
+        uint64_t base;
+        if (end - position < 4 || std::memcmp(position, LOG4CPP_BINARY_MAGIC, 4) != 0)
+        {
+            return false;
+        }
+        position += 4;
+        if (!readVarint(version) || version != LOG4CPP_BINARY_VERSION || !readVarint(base))
+        {
+            return false;
+        }
+        strings.clear();
+        sites.clear();
+        lastTimestampNs = static_cast<int64_t>(base);
+        segmentOpen = true;
+        return true;
+    }
+
+    bool readSite()
+    {
+        uint64_t file;
+        uint64_t function;
+        uint64_t line;
+        if (!readVarint(file) || !readVarint(function) || !readVarint(line) ||
+            file >= strings.size() || function >= strings.size())
+        {
+            return false;
+        }
+        sites.push_back(Site{static_cast<uint32_t>(file), static_cast<uint32_t>(function),
+                             static_cast<int>(zigzagDecode(line))});
+        return true;
+    }
+
+    bool readField(LogField &field, std::string &text)
+    {
+        uint64_t value;
+        if (!readStringId(field.key) || position >= end)
+        {
+            return false;
+        }
+        uint8_t type = static_cast<uint8_t>(*position++);
+        field.type = static_cast<LogFieldType>(type);
+        field.stringValue = LogStringRef();
+        switch (field.type)
+        {
+        case LogFieldType::INT:
+            if (!readVarint(value))
+            {
+                return false;
+            }
+            field.intValue = zigzagDecode(value);
+            return true;
+        case LogFieldType::UINT:
+            if (!readVarint(value))
+            {
+                return false;
+            }
+            field.uintValue = value;
+            return true;
+        case LogFieldType::DOUBLE:
+            if (end - position < 8)
+            {
+                return false;
+            }
+            value = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                value |= static_cast<uint64_t>(static_cast<uint8_t>(position[i])) << (i * 8);
+            }
+            position += 8;
+            std::memcpy(&field.doubleValue, &value, sizeof(value));
+            return true;
+        case LogFieldType::BOOL:
+            if (position >= end)
+            {
+                return false;
+            }
+            field.boolValue = *position++ != 0;
+            return true;
+        case LogFieldType::STRING:
+            if (!readVarint(value) || !readBytes(static_cast<size_t>(value), text))
+            {
+                return false;
+            }
+            field.stringValue = LogStringRef(text.c_str(), text.size());
+            return true;
+        }
+        return false;
+    }
+
+    bool readEntry(LogEntry &entry)
+    {
+        uint64_t level;
+        uint64_t delta;
+        uint64_t site;
+        uint64_t threadId;
+        uint64_t processId;
+        uint64_t messageLength;
+        uint64_t fieldCount;
+
+        if (!readVarint(level) || level > static_cast<uint64_t>(LogLevel::ERROR) ||
+            !readVarint(delta) || !readVarint(site) || site >= sites.size() ||
+            !readStringId(entry.component) || !readVarint(threadId) || !readStringId(entry.threadName) ||
+            !readVarint(processId) || !readVarint(messageLength) ||
+            !readBytes(static_cast<size_t>(messageLength), message) || !readVarint(fieldCount) ||
+            fieldCount > static_cast<uint64_t>(end - position))
+        {
+            return false;
+        }
+
+        // Size both vectors before handing out pointers into them
+        fields.resize(static_cast<size_t>(fieldCount));
+        fieldStrings.resize(static_cast<size_t>(fieldCount));
+        for (size_t i = 0; i < fields.size(); ++i)
+        {
+            if (!readField(fields[i], fieldStrings[i]))
+            {
+                return false;
+            }
+        }
+
+        const Site &location = sites[static_cast<size_t>(site)];
+        const LogLevelInfo &info = logLevelInfo(static_cast<LogLevel>(level));
+        lastTimestampNs += zigzagDecode(delta);
+        formatTimestamp(lastTimestampNs);
+
+        entry.timestamp = LogStringRef(timestampText);
+        entry.level = LogStringRef(info.name, info.nameLength);
+        entry.file = LogStringRef(strings[location.file].c_str(), strings[location.file].size());
+        entry.function = LogStringRef(strings[location.function].c_str(), strings[location.function].size());
+        entry.lineNumber = location.line;
+        entry.message = LogStringRef(message.c_str(), message.size());
+        entry.threadId = threadId;
+        entry.processId = static_cast<int>(processId);
+        entry.severity = static_cast<LogLevel>(level);
+        entry.timestampNs = lastTimestampNs;
+        entry.fields = fields.empty() ? nullptr : fields.data();
+        entry.fieldCount = fields.size();
+        return true;
+    }
+
+    bool next(LogEntry &entry)
+    {
+        while (!error && position < end)
+        {
+            uint8_t tag = static_cast<uint8_t>(*position++);
+            if (tag != BINARY_TAG_SEGMENT && !segmentOpen)
+            {
+                return fail();
+            }
+
+            switch (tag)
+            {
+            case BINARY_TAG_SEGMENT:
+                if (!readSegment())
+                {
+                    return fail();
+                }
+                break;
+            case BINARY_TAG_STRING:
+            {
+                uint64_t length;
+                strings.emplace_back();
+                if (!readVarint(length) || !readBytes(static_cast<size_t>(length), strings.back()))
+                {
+                    return fail();
+                }
+                break;
+            }
+            case BINARY_TAG_SITE:
+                if (!readSite())
+                {
+                    return fail();
+                }
+                break;
+            case BINARY_TAG_ENTRY:
+                return readEntry(entry) || fail();
+            default:
+                return fail();
+            }
+        }
+        return false;
+    }
+};
+
+// ========== BinaryLogDecoder Implementation ==========
+
+BinaryLogDecoder::BinaryLogDecoder(const char *data, size_t size) : impl(std::make_unique<Impl>(data, size))
+{
+}
+
+BinaryLogDecoder::~BinaryLogDecoder() = default;
+
+bool BinaryLogDecoder::next(LogEntry &entry)
+{
+    return impl->next(entry);
+}
+
+bool BinaryLogDecoder::failed() const
+{
+    return impl->error;
+}
+
+// ========== JSON Lines Conversion ==========
+
+void appendJsonString(std::string &out, LogStringRef text)
+{
+    out += '"';
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char escape[8];
+                std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(c));
+                out += escape;
+            }
+            else
+            {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+static void appendJsonNumber(std::string &out, const char *format, ...)
+{
+    char digits[32];
+    va_list args;
+    va_start(args, format);
+    int length = std::vsnprintf(digits, sizeof(digits), format, args);
+    va_end(args);
+    out.append(digits, static_cast<size_t>(length));
+}
+
+static void appendJsonField(std::string &out, const LogField &field)
+{
+    appendJsonString(out, field.key);
+    out += ':';
+    switch (field.type)
+    {
+    case LogFieldType::INT:
+        appendJsonNumber(out, "%lld", static_cast<long long>(field.intValue));
+        break;
+    case LogFieldType::UINT:
+        appendJsonNumber(out, "%llu", static_cast<unsigned long long>(field.uintValue));
+        break;
+    case LogFieldType::DOUBLE:
+        if (std::isfinite(field.doubleValue))
+        {
+            appendJsonNumber(out, "%.17g", field.doubleValue);
+        }
+        else
+        {
+            out += "null";
+        }
+        break;
+    case LogFieldType::BOOL:
+        out += field.boolValue ? "true" : "false";
+        break;
+    case LogFieldType::STRING:
+        appendJsonString(out, field.stringValue);
+        break;
+    }
+}
+
+void appendLogEntryJson(const LogEntry &entry, std::string &out)
+{
+    out += "{\"timestamp\":";
+    appendJsonString(out, entry.timestamp);
+    out += ",\"timestamp_ns\":";
+    appendJsonNumber(out, "%lld", static_cast<long long>(entry.timestampNs));
+    out += ",\"level\":";
+    appendJsonString(out, entry.level);
+    out += ",\"component\":";
+    appendJsonString(out, entry.component);
+    out += ",\"file\":";
+    appendJsonString(out, entry.file);
+    out += ",\"function\":";
+    appendJsonString(out, entry.function);
+    out += ",\"line\":";
+    appendJsonNumber(out, "%d", entry.lineNumber);
+    out += ",\"thread_id\":";
+    appendJsonNumber(out, "%llu", static_cast<unsigned long long>(entry.threadId));
+    out += ",\"thread_name\":";
+    appendJsonString(out, entry.threadName);
+    out += ",\"pid\":";
+    appendJsonNumber(out, "%d", entry.processId);
+    out += ",\"message\":";
+    appendJsonString(out, entry.message);
+    if (entry.fieldCount > 0)
+    {
+        out += ",\"fields\":{";
+        for (size_t i = 0; i < entry.fieldCount; ++i)
+        {
+            if (i > 0)
+            {
+                out += ',';
+            }
+            appendJsonField(out, entry.fields[i]);
+        }
+        out += '}';
+    }
+    out += '}';
+}
+
+// Decode one run of segments; false if it ends in malformed data
+static bool convertToJsonLines(const char *data, size_t size, std::ostream &out, long &count)
+{
+    BinaryLogDecoder decoder(data, size);
+    LogEntry entry{};
+    std::string line;
+    while (decoder.next(entry))
+    {
+        line.clear();
+        appendLogEntryJson(entry, line);
+        line += '\n';
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+        ++count;
+    }
+    return !decoder.failed();
+}
+
+long binaryLogToJsonLines(const std::string &path, std::ostream &out)
+{
+    std::ifstream input(path, std::ios::binary);
+    if (!input)
+    {
+        return -1;
+    }
+    std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    long count = 0;
+    if (!isFramedLog(data.data(), data.size()))
+    {
+        return convertToJsonLines(data.data(), data.size(), out, count) ? count : -1;
+    }
+
+    // Checksummed blocks each hold complete segments; damaged ones are skipped
+    scanLogFrames(data.data(), data.size(), [&](const char *payload, size_t size)
+                  { convertToJsonLines(payload, size, out, count); });
+    return count;
+}
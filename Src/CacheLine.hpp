@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Cache line size on the targets we build for
+#define LOG4CPP_CACHE_LINE_SIZE 64
+
+/**
+ * CacheLineAligned - Base for classes with alignas(LOG4CPP_CACHE_LINE_SIZE)
+ * members
+ *
+ * C++14 operator new only guarantees alignof(std::max_align_t), so heap
+ * instances are placed on a cache-line boundary explicitly.
+ */
+struct CacheLineAligned
+{
+    static void *operator new(size_t size)
+    {
+        void *memory = nullptr;
+        if (posix_memalign(&memory, LOG4CPP_CACHE_LINE_SIZE, size) != 0)
+        {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    static void operator delete(void *memory)
+    {
+        std::free(memory);
+    }
+};
@@ -0,0 +1,230 @@
+#include "ChromeTraceHandler.hpp"
+#include "BinaryLogFormat.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+
+// ========== Helpers ==========
+
+// Trace timestamps are microseconds; keep nanosecond precision as decimals
+static void appendMicroseconds(std::string &out, int64_t ns)
+{
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%lld.%03lld", static_cast<long long>(ns / 1000),
+                               static_cast<long long>(ns % 1000));
+    out.append(digits, static_cast<size_t>(length));
+}
+
+static void appendInteger(std::string &out, long long value)
+{
+    char digits[24];
+    int length = std::snprintf(digits, sizeof(digits), "%lld", value);
+    out.append(digits, static_cast<size_t>(length));
+}
+
+// The span name and duration of a LOG_CPP_SPAN entry; false for other entries
+static bool findSpan(const LogEntry &entry, LogStringRef &name, uint64_t &durationNs)
+{
+    bool hasName = false;
+    bool hasDuration = false;
+    for (size_t i = 0; i < entry.fieldCount; ++i)
+    {
+        const LogField &field = entry.fields[i];
+        if (field.type == LogFieldType::STRING && field.key == "span")
+        {
+            name = field.stringValue;
+            hasName = true;
+        }
+        else if (field.type == LogFieldType::UINT && field.key == "durationNs")
+        {
+            durationNs = field.uintValue;
+            hasDuration = true;
+        }
+    }
+    return hasName && hasDuration;
+}
+
+// ========== ChromeTraceHandler::Impl Definition ==========
+
+class ChromeTraceHandler::Impl
+{
+public:
+    std::string path;
+    bool includeMessages;
+    int fd;
+    bool firstEvent;
+    bool closed;
+    std::string pending; // Events of the current batch
+    std::unordered_map<uint64_t, std::string> threadNames; // Last name emitted per thread
+
+    Impl(const std::string &file, bool messages)
+        : path(file), includeMessages(messages), firstEvent(true), closed(false)
+    {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            std::cerr << "Error opening trace file: " << path << " (" << std::strerror(errno) << ")\n";
+            return;
+        }
+        pending = "[\n";
+    }
+
+    ~Impl()
+    {
+        close();
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+
+    void beginEvent()
+    {
+        if (!firstEvent)
+        {
+            pending += ",\n";
+        }
+        firstEvent = false;
+    }
+
+    // Process and thread ids of an event
+    void appendIds(const LogEntry &entry)
+    {
+        pending += ",\"pid\":";
+        appendInteger(pending, entry.processId);
+        pending += ",\"tid\":";
+        appendInteger(pending, static_cast<long long>(entry.threadId));
+    }
+
+    void noteThreadName(const LogEntry &entry)
+    {
+        auto known = threadNames.find(entry.threadId);
+        if (known != threadNames.end() && LogStringRef(known->second) == entry.threadName)
+        {
+            return;
+        }
+        threadNames[entry.threadId].assign(entry.threadName.data(), entry.threadName.size());
+        beginEvent();
+        pending += "{\"name\":\"thread_name\",\"ph\":\"M\"";
+        appendIds(entry);
+        pending += ",\"args\":{\"name\":";
+        appendJsonString(pending, entry.threadName);
+        pending += "}}";
+    }
+
+    void write(const LogEntry &entry)
+    {
+        if (fd < 0 || closed)
+        {
+            return;
+        }
+
+        LogStringRef spanName;
+        uint64_t durationNs = 0;
+        bool span = findSpan(entry, spanName, durationNs);
+        if (!span && !includeMessages)
+        {
+            return;
+        }
+
+        noteThreadName(entry);
+        beginEvent();
+        pending += "{\"name\":";
+        appendJsonString(pending, span ? spanName : entry.message);
+        pending += ",\"cat\":";
+        appendJsonString(pending, entry.component);
+        if (span)
+        {
+            pending += ",\"ph\":\"X\",\"ts\":";
+            appendMicroseconds(pending, entry.timestampNs);
+            pending += ",\"dur\":";
+            appendMicroseconds(pending, static_cast<int64_t>(durationNs));
+        }
+        else
+        {
+            pending += ",\"ph\":\"i\",\"s\":\"t\",\"ts\":";
+            appendMicroseconds(pending, entry.timestampNs);
+        }
+        appendIds(entry);
+        pending += ",\"args\":{\"level\":";
+        appendJsonString(pending, entry.level);
+        pending += ",\"function\":";
+        appendJsonString(pending, entry.function);
+        pending += ",\"line\":";
+        appendInteger(pending, entry.lineNumber);
+        pending += "}}";
+    }
+
+    void flush()
+    {
+        if (fd < 0 || pending.empty())
+        {
+            return;
+        }
+        size_t written = 0;
+        while (written < pending.size())
+        {
+            ssize_t result = ::write(fd, pending.data() + written, pending.size() - written);
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                std::cerr << "Error writing trace file: " << path << " (" << std::strerror(errno) << ")\n";
+                break;
+            }
+            written += static_cast<size_t>(result);
+        }
+        pending.clear();
+    }
+
+    void close()
+    {
+        if (fd < 0 || closed)
+        {
+            return;
+        }
+        pending += "\n]\n";
+        flush();
+        closed = true;
+    }
+};
+
+// ========== ChromeTraceHandler Implementation ==========
+
+ChromeTraceHandler::ChromeTraceHandler(const std::string &path, bool includeMessages)
+    : impl(new Impl(path, includeMessages))
+{
+}
+
+ChromeTraceHandler::~ChromeTraceHandler() = default;
+
+void ChromeTraceHandler::write(const LogEntry &entry)
+{
+    impl->write(entry);
+}
+
+void ChromeTraceHandler::flush()
+{
+    impl->flush();
+}
+
+void ChromeTraceHandler::close()
+{
+    impl->close();
+}
+
+void registerChromeTraceHandler(const std::string &path, bool includeMessages)
+{
+    ChromeTraceHandler *handler = new ChromeTraceHandler(path, includeMessages);
+    Logger::getInstance()->registerHandler(std::bind(&ChromeTraceHandler::write, handler, std::placeholders::_1));
+    Logger::getInstance()->registerFlushHandler(std::bind(&ChromeTraceHandler::flush, handler));
+    Logger::getInstance()->registerCloseHandler(std::bind(&ChromeTraceHandler::close, handler));
+}
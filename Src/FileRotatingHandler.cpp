@@ -1,45 +1,120 @@
 #include "FileRotatingHandler.hpp"
-#include <sstream>
-#include <iomanip>
+#include "CacheLine.hpp"
+#include "LogFraming.hpp"
 #include <iostream>
-#include <fstream>
 #include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <sys/uio.h>
+#include <algorithm>
+#include <atomic>
 #include <vector>
 #include <mutex>
 
+// ========== Helpers ==========
+
+// Cheap clock for the probe schedule; a few milliseconds of resolution is plenty
+static int64_t coarseNowNs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
 // ========== FileRotatingHandler::Impl Definition ==========
 
-class FileRotatingHandler::Impl
+class FileRotatingHandler::Impl : public CacheLineAligned
 {
 public:
+    // ---- Configuration: read on every write, rarely changed ----
     std::string basePath;
     size_t maxFileSize;
     int maxBackups;
-    std::ofstream currentFile;
-    size_t currentSize;
+    bool defaultFormat;
     FileRotatingHandler::Formatter formatter;
-    mutable std::mutex fileMutex;
+    std::shared_ptr<LogEncoder> encoder; // Replaces the text layout when set
+    bool compress;                       // Compress each batch into its own frame
+    bool framed;                         // Write batches as CRC32C-checked blocks
+    size_t blockSize;
+    int64_t probeIntervalNs;             // Circuit breaker settings, see Options
+    uint64_t minFreeBytes;
+    bool deleteBackupsWhenFull;
+    std::string directory;               // Where free space is probed
+
+    // ---- Circuit breaker: set when a write fails, cleared by a probe ----
+    // While suspended, write() only bumps the counter until the next probe
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::atomic<bool> suspended;
+    std::atomic<int64_t> nextProbeNs;
+    std::atomic<uint64_t> discarded; // Entries lost since the breaker tripped
+
+    // ---- Mutable file state, updated on every write under fileMutex ----
+    // Starts on its own cache line so size updates do not invalidate the
+    // configuration above
+    alignas(LOG4CPP_CACHE_LINE_SIZE) mutable std::mutex fileMutex;
+    int fd;
+    size_t currentSize;
+    std::string prefixBuffer; // Reused for the default line prefix
+    std::string encodeBuffer; // Reused for encoder output
+    std::string blockBuffer;  // Current batch when framed
+    std::string frameBuffer;  // Compressed frame of the batch being written
 
-    Impl(const std::string &path, size_t maxSize, int backups, FileRotatingHandler::Formatter fmt)
-        : basePath(path), maxFileSize(maxSize), maxBackups(backups), currentSize(0), formatter(fmt)
+    // Seek table of the current file, written when it is closed
+    std::vector<LogFrameIndexEntry> frameIndex; // Runs of blocks since indexedFrom
+    size_t indexedFrom;                         // Where the table's coverage starts
+    std::string seekTableBuffer;
+    int64_t batchOldestNs;
+    int64_t batchNewestNs;
+    uint32_t batchLevels;
+    size_t batchEntries;
+
+    Impl(const std::string &path, size_t maxSize, int backups, const FileRotatingHandler::Options &options)
+        : basePath(path), maxFileSize(maxSize), maxBackups(backups), defaultFormat(!options.formatter),
+          formatter(options.formatter), encoder(options.encoder), compress(options.compress),
+          framed(options.checksumBlocks || options.compress), blockSize(options.blockSize),
+          probeIntervalNs(static_cast<int64_t>(options.probeIntervalMs) * 1000000), minFreeBytes(options.minFreeBytes),
+          deleteBackupsWhenFull(options.deleteBackupsWhenFull), suspended(false), nextProbeNs(0), discarded(0), fd(-1),
+          currentSize(0), indexedFrom(0)
     {
-        if (!formatter)
-        {
-            formatter = defaultFormatter;
-        }
+        size_t slash = basePath.rfind('/');
+        directory = slash == std::string::npos ? "." : slash == 0 ? "/" : basePath.substr(0, slash);
+        resetBatch();
         openFile();
     }
 
-    static std::string defaultFormatter(const LogEntry &entry)
+    ~Impl()
+    {
+        flushBlock();
+        closeCurrent();
+    }
+
+    static void appendDecimal(std::string &out, int value)
     {
-        std::ostringstream oss;
-        oss << "[" << entry.timestamp << "]"
-            << "[" << std::left << std::setw(6) << entry.level << "]"
-            << "[" << entry.component << "]"
-            << "[" << entry.function << ":" << entry.lineNumber << "] "
-            << entry.message;
-        return oss.str();
+        char digits[16];
+        int length = std::snprintf(digits, sizeof(digits), "%d", value);
+        out.append(digits, static_cast<size_t>(length));
+    }
+
+    // Default format is "[timestamp][level ][component][function:line] message".
+    // Only the prefix is built here; the message is written from the entry.
+    static void formatDefaultPrefix(const LogEntry &entry, std::string &out)
+    {
+        out.clear();
+        out += '[';
+        out.append(entry.timestamp.data(), entry.timestamp.size());
+        out += "][";
+        out.append(logLevelInfo(entry.severity).padded, LOG4CPP_LEVEL_WIDTH);
+        out += "][";
+        out.append(entry.component.data(), entry.component.size());
+        out += "][";
+        out.append(entry.function.data(), entry.function.size());
+        out += ':';
+        appendDecimal(out, entry.lineNumber);
+        out += "] ";
     }
 
     static size_t getFileSize(const std::string &path)
@@ -58,13 +133,38 @@ public:
         return stat(path.c_str(), &statbuf) == 0;
     }
 
-    void openFile()
+    void openCurrent()
     {
-        std::lock_guard<std::mutex> lock(fileMutex);
-        if (currentFile.is_open())
+        fd = ::open(basePath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0 && (errno == ENOSPC || errno == EDQUOT || errno == EIO))
+        {
+            // No room for even a new file (e.g. after rotating)
+            suspend(errno);
+        }
+        frameIndex.clear();
+        indexedFrom = currentSize;
+        if (encoder)
         {
-            currentFile.close();
+            // Every file, including one appended to after a restart, gets
+            // a fresh self-describing segment
+            encoder->beginSegment();
         }
+    }
+
+    void closeCurrent()
+    {
+        if (fd >= 0)
+        {
+            writeSeekTable();
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    void openFile()
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        closeCurrent();
 
         // Check if file already exists to get its size
         currentSize = 0;
@@ -73,15 +173,146 @@ public:
             currentSize = getFileSize(basePath);
         }
 
-        currentFile.open(basePath, std::ios::app);
+        openCurrent();
     }
 
-    void rotate()
+    // Write all segments, resuming after partial writes and interrupts
+    bool writeSegments(struct iovec *segments, int count)
     {
-        if (currentFile.is_open())
+        while (count > 0)
         {
-            currentFile.close();
+            ssize_t written = ::writev(fd, segments, count);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+
+            size_t remaining = static_cast<size_t>(written);
+            while (count > 0 && remaining >= segments->iov_len)
+            {
+                remaining -= segments->iov_len;
+                ++segments;
+                --count;
+            }
+            if (count > 0)
+            {
+                segments->iov_base = static_cast<char *>(segments->iov_base) + remaining;
+                segments->iov_len -= remaining;
+            }
         }
+        return true;
+    }
+
+    // Write to the current file; on failure drop any partial write, trip the
+    // breaker and count the `entries` that were lost
+    bool writeOut(struct iovec *segments, int count, size_t entries)
+    {
+        if (!suspended.load(std::memory_order_relaxed) && writeSegments(segments, count))
+        {
+            return true;
+        }
+        if (!suspended.load(std::memory_order_relaxed))
+        {
+            int error = errno;
+            if (ftruncate(fd, static_cast<off_t>(currentSize)) != 0)
+            {
+                // Keep the torn tail; readers skip it as after a crash
+            }
+            suspend(error);
+        }
+        discarded.fetch_add(entries, std::memory_order_relaxed);
+        return false;
+    }
+
+    // ---- Circuit breaker ----
+
+    void suspend(int error)
+    {
+        suspended.store(true, std::memory_order_relaxed);
+        nextProbeNs.store(coarseNowNs() + probeIntervalNs, std::memory_order_relaxed);
+        std::cerr << "Error writing log file: " << basePath << " (" << std::strerror(error)
+                  << "), discarding entries until it is writable again\n";
+    }
+
+    uint64_t freeBytes() const
+    {
+        struct statvfs stats;
+        if (statvfs(directory.c_str(), &stats) != 0)
+        {
+            return 0;
+        }
+        return static_cast<uint64_t>(stats.f_bavail) * stats.f_frsize;
+    }
+
+    // Remove the highest-numbered backup; false if there is none
+    bool deleteOldestBackup()
+    {
+        for (int i = maxBackups; i >= 1; --i)
+        {
+            std::string backupPath = basePath + "." + std::to_string(i);
+            if (fileExists(backupPath))
+            {
+                std::remove(backupPath.c_str());
+                std::cerr << "Deleted log backup to free space: " << backupPath << "\n";
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Called while suspended: true once a probe finds enough free space and
+    // writing resumes, false while entries are still to be discarded
+    bool probe()
+    {
+        int64_t now = coarseNowNs();
+        if (now < nextProbeNs.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(fileMutex);
+        if (!suspended.load(std::memory_order_relaxed))
+        {
+            return true; // Another thread's probe succeeded
+        }
+        if (now < nextProbeNs.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+        nextProbeNs.store(now + probeIntervalNs, std::memory_order_relaxed);
+
+        uint64_t available = freeBytes();
+        while (available < minFreeBytes && deleteBackupsWhenFull && deleteOldestBackup())
+        {
+            available = freeBytes();
+        }
+        if (available < minFreeBytes)
+        {
+            return false;
+        }
+
+        suspended.store(false, std::memory_order_relaxed);
+        if (fd < 0)
+        {
+            currentSize = getFileSize(basePath);
+            openCurrent();
+            if (fd < 0)
+            {
+                return false;
+            }
+        }
+        std::cerr << "Log file writable again: " << basePath << " ("
+                  << discarded.exchange(0, std::memory_order_relaxed) << " entries discarded)\n";
+        return true;
+    }
+
+    void rotate()
+    {
+        closeCurrent();
 
         try
         {
@@ -117,41 +348,312 @@ public:
 
         // Open new file
         currentSize = 0;
-        currentFile.open(basePath, std::ios::app);
+        openCurrent();
+    }
+
+    void writeEncoded(const LogEntry &entry)
+    {
+        encodeBuffer.clear();
+        encoder->encode(entry, encodeBuffer);
+        if (currentSize > 0 && currentSize + encodeBuffer.size() > maxFileSize)
+        {
+            // The new segment has to repeat the definitions, so encode again
+            rotate();
+            encodeBuffer.clear();
+            encoder->encode(entry, encodeBuffer);
+        }
+
+        struct iovec segment = {const_cast<char *>(encodeBuffer.data()), encodeBuffer.size()};
+        if (fd >= 0 && writeOut(&segment, 1, 1))
+        {
+            currentSize += encodeBuffer.size();
+        }
+    }
+
+    // Append the entry as it would appear in an unframed file
+    void appendEntry(const LogEntry &entry, std::string &out)
+    {
+        if (encoder)
+        {
+            encoder->encode(entry, out);
+        }
+        else if (defaultFormat)
+        {
+            formatDefaultPrefix(entry, prefixBuffer);
+            out += prefixBuffer;
+            out.append(entry.message.data(), entry.message.size());
+            out += '\n';
+        }
+        else
+        {
+            out += formatter(entry);
+            out += '\n';
+        }
+    }
+
+    void resetBatch()
+    {
+        batchOldestNs = INT64_MAX;
+        batchNewestNs = INT64_MIN;
+        batchLevels = 0;
+        batchEntries = 0;
+    }
+
+    void noteBatchEntry(const LogEntry &entry)
+    {
+        batchOldestNs = std::min(batchOldestNs, entry.timestampNs);
+        batchNewestNs = std::max(batchNewestNs, entry.timestampNs);
+        batchLevels |= 1u << static_cast<unsigned>(entry.severity);
+        ++batchEntries;
+    }
+
+    // Bytes to keep free for the seek table if one more block is written
+    size_t seekTableReserve() const
+    {
+        return LOG4CPP_FRAME_HEADER_SIZE + 16 + (frameIndex.size() + 1) * LOG4CPP_FRAME_INDEX_ENTRY_SIZE;
+    }
+
+    // Add the block just written to the seek table. Neighbouring blocks are
+    // merged into runs of about blockSize bytes to keep the table small.
+    void indexBlock(size_t offset, size_t size, int64_t oldestNs, int64_t newestNs, uint32_t levels)
+    {
+        if (!frameIndex.empty() && frameIndex.back().size < blockSize &&
+            frameIndex.back().offset + frameIndex.back().size == offset)
+        {
+            LogFrameIndexEntry &run = frameIndex.back();
+            run.size += static_cast<uint32_t>(size);
+            run.oldestNs = std::min(run.oldestNs, oldestNs);
+            run.newestNs = std::max(run.newestNs, newestNs);
+            run.levelMask |= levels;
+            return;
+        }
+        frameIndex.push_back({offset, static_cast<uint32_t>(size), oldestNs, newestNs, levels});
+    }
+
+    void writeSeekTable()
+    {
+        if (!framed || frameIndex.empty() || fd < 0)
+        {
+            return;
+        }
+        // Own buffer: a rotation in flushBlock() gets here with the frame
+        // still in frameBuffer
+        seekTableBuffer.clear();
+        appendLogFrameIndex(frameIndex, indexedFrom, seekTableBuffer);
+        struct iovec segment = {const_cast<char *>(seekTableBuffer.data()), seekTableBuffer.size()};
+        if (writeOut(&segment, 1, 0))
+        {
+            currentSize += seekTableBuffer.size();
+        }
+        frameIndex.clear();
+        indexedFrom = currentSize;
+    }
+
+    // Write the pending batch as one checksummed (and possibly compressed)
+    // block. Rotation happens between blocks, so maxFileSize counts the bytes
+    // actually written and no block is ever split across two files.
+    void flushBlock()
+    {
+        if (blockBuffer.empty())
+        {
+            return;
+        }
+
+        char header[LOG4CPP_FRAME_HEADER_SIZE];
+        struct iovec segments[2];
+        int segmentCount = 0;
+        if (compress)
+        {
+            frameBuffer.clear();
+            appendCompressedLogFrame(blockBuffer.data(), blockBuffer.size(), frameBuffer);
+            segments[segmentCount++] = {const_cast<char *>(frameBuffer.data()), frameBuffer.size()};
+        }
+        else
+        {
+            makeLogFrameHeader(blockBuffer.data(), blockBuffer.size(), header);
+            segments[segmentCount++] = {header, sizeof(header)};
+            segments[segmentCount++] = {const_cast<char *>(blockBuffer.data()), blockBuffer.size()};
+        }
+
+        size_t frameSize = 0;
+        for (int i = 0; i < segmentCount; ++i)
+        {
+            frameSize += segments[i].iov_len;
+        }
+        if (currentSize > 0 && currentSize + frameSize + seekTableReserve() > maxFileSize)
+        {
+            // Blocks start a fresh encoder segment, so this one can open the new file
+            rotate();
+        }
+
+        if (fd >= 0 && writeOut(segments, segmentCount, batchEntries))
+        {
+            indexBlock(currentSize, frameSize, batchOldestNs, batchNewestNs, batchLevels);
+            currentSize += frameSize;
+        }
+        blockBuffer.clear();
+        resetBatch();
+
+        if (encoder)
+        {
+            // Each block decodes on its own, even if its neighbours are lost
+            encoder->beginSegment();
+        }
+    }
+
+    void writeFramed(const LogEntry &entry)
+    {
+        if (blockBuffer.size() >= blockSize)
+        {
+            flushBlock();
+        }
+
+        size_t batchSize = blockBuffer.size();
+        appendEntry(entry, blockBuffer);
+        if (!compress && batchSize > 0 &&
+            currentSize + LOG4CPP_FRAME_HEADER_SIZE + blockBuffer.size() + seekTableReserve() > maxFileSize)
+        {
+            // Uncompressed blocks have a known size: close the batch while it
+            // still fits the current file, and start the next with this entry
+            blockBuffer.resize(batchSize);
+            flushBlock();
+            appendEntry(entry, blockBuffer);
+        }
+        noteBatchEntry(entry);
     }
 
     void write(const LogEntry &entry)
     {
+        // Breaker tripped: not even formatted until a probe succeeds
+        if (suspended.load(std::memory_order_relaxed) && !probe())
+        {
+            discarded.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
         std::lock_guard<std::mutex> lock(fileMutex);
 
-        // Format the log line using custom formatter
-        std::string logLine = formatter(entry) + "\n";
-        size_t logSize = logLine.length();
+        if (framed)
+        {
+            writeFramed(entry);
+            return;
+        }
+
+        if (encoder)
+        {
+            writeEncoded(entry);
+            return;
+        }
+
+        // The line is handed to writev() as segments so the message, which
+        // may be several megabytes, is written straight from the logger's
+        // buffer instead of being copied into a formatted line first
+        static const char newline = '\n';
+        struct iovec segments[3];
+        int segmentCount = 0;
+        std::string formatted;
+
+        if (defaultFormat)
+        {
+            formatDefaultPrefix(entry, prefixBuffer);
+            segments[segmentCount++] = {const_cast<char *>(prefixBuffer.data()), prefixBuffer.size()};
+            segments[segmentCount++] = {const_cast<char *>(entry.message.data()), entry.message.size()};
+        }
+        else
+        {
+            // Format the log line using custom formatter
+            formatted = formatter(entry);
+            segments[segmentCount++] = {const_cast<char *>(formatted.data()), formatted.size()};
+        }
+        segments[segmentCount++] = {const_cast<char *>(&newline), 1};
 
-        // Check if rotation needed
-        if (currentSize + logSize > maxFileSize)
+        size_t logSize = 0;
+        for (int i = 0; i < segmentCount; ++i)
+        {
+            logSize += segments[i].iov_len;
+        }
+
+        // Check if rotation needed. A line larger than maxFileSize goes into
+        // the current file if it is still empty rather than rotating out an
+        // empty file on every oversized message.
+        if (currentSize > 0 && currentSize + logSize > maxFileSize)
         {
             rotate();
         }
 
         // Write to file
-        if (currentFile.is_open())
+        if (fd >= 0 && writeOut(segments, segmentCount, 1))
         {
-            currentFile << logLine;
-            currentFile.flush();
             currentSize += logSize;
         }
     }
 
+    // Out of memory: write the line the logger laid out in its preallocated
+    // buffer, without allocating or rotating. Framed files get it as a
+    // plain block of its own, ahead of the entries still buffered; encoded
+    // files are skipped, since a text line would corrupt them.
+    void writeEmergency(const LogEntry &entry, LogStringRef line)
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        if (fd < 0 || encoder)
+        {
+            return;
+        }
+
+        char header[LOG4CPP_FRAME_HEADER_SIZE];
+        struct iovec segments[2];
+        int segmentCount = 0;
+        if (framed)
+        {
+            makeLogFrameHeader(line.data(), line.size(), header);
+            segments[segmentCount++] = {header, sizeof(header)};
+        }
+        segments[segmentCount++] = {const_cast<char *>(line.data()), line.size()};
+        size_t size = (framed ? sizeof(header) : 0) + line.size();
+        if (!writeOut(segments, segmentCount, 1))
+        {
+            return;
+        }
+        if (framed)
+        {
+            try
+            {
+                indexBlock(currentSize, size, entry.timestampNs, entry.timestampNs,
+                           1u << static_cast<unsigned>(entry.severity));
+            }
+            catch (const std::bad_alloc &)
+            {
+                // Still readable in order, just not found by range queries
+            }
+        }
+        currentSize += size;
+    }
+
+    // End of a batch: write out the pending block
+    void flush()
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        flushBlock();
+    }
+
+    // End of output: finish the file with its seek table. Later blocks
+    // start a new table, chained to this one.
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        flushBlock();
+        writeSeekTable();
+    }
+
     void setFormatter(FileRotatingHandler::Formatter fmt)
     {
         std::lock_guard<std::mutex> lock(fileMutex);
         if (fmt)
         {
             formatter = fmt;
+            defaultFormat = false;
         }
     }
-
     std::string getCurrentPath() const
     {
         return basePath;
@@ -166,13 +668,38 @@ public:
 
 // ========== FileRotatingHandler Implementation ==========
 
+static FileRotatingHandler::Options formatterOptions(FileRotatingHandler::Formatter fmt)
+{
+    FileRotatingHandler::Options options;
+    options.formatter = std::move(fmt);
+    return options;
+}
+
+static FileRotatingHandler::Options encoderOptions(std::shared_ptr<LogEncoder> encoder)
+{
+    FileRotatingHandler::Options options;
+    options.encoder = std::move(encoder);
+    return options;
+}
+
 FileRotatingHandler::FileRotatingHandler(const std::string &path, size_t maxSize, int backups)
-    : impl(std::make_unique<Impl>(path, maxSize, backups, nullptr))
+    : impl(std::make_unique<Impl>(path, maxSize, backups, Options()))
 {
 }
 
 FileRotatingHandler::FileRotatingHandler(const std::string &path, size_t maxSize, int backups, Formatter fmt)
-    : impl(std::make_unique<Impl>(path, maxSize, backups, fmt))
+    : impl(std::make_unique<Impl>(path, maxSize, backups, formatterOptions(fmt)))
+{
+}
+
+FileRotatingHandler::FileRotatingHandler(const std::string &path, size_t maxSize, int backups,
+                                         std::shared_ptr<LogEncoder> encoder)
+    : impl(std::make_unique<Impl>(path, maxSize, backups, encoderOptions(std::move(encoder))))
+{
+}
+
+FileRotatingHandler::FileRotatingHandler(const std::string &path, size_t maxSize, int backups, const Options &options)
+    : impl(std::make_unique<Impl>(path, maxSize, backups, options))
 {
 }
 
@@ -185,13 +712,32 @@ void FileRotatingHandler::write(const LogEntry &entry)
     impl->write(entry);
 }
 
+void FileRotatingHandler::flush()
+{
+    impl->flush();
+}
+
+void FileRotatingHandler::close()
+{
+    impl->close();
+}
+
+void FileRotatingHandler::writeEmergency(const LogEntry &entry, LogStringRef line)
+{
+    impl->writeEmergency(entry, line);
+}
+
 // ========== Convenience Functions ==========
 
+// Handlers live as long as the Logger singleton (intentionally never freed),
+// so an asynchronous backend draining at exit never writes to a destroyed one
+
 void registerFileRotatingHandler(const std::string &path, size_t maxSize, int maxBackups)
 {
-    static FileRotatingHandler handler(path, maxSize, maxBackups);
+    FileRotatingHandler *handler = new FileRotatingHandler(path, maxSize, maxBackups);
     Logger::getInstance()->registerHandler(
-        std::bind(&FileRotatingHandler::write, &handler, std::placeholders::_1));
+        std::bind(&FileRotatingHandler::write, handler, std::placeholders::_1),
+        std::bind(&FileRotatingHandler::writeEmergency, handler, std::placeholders::_1, std::placeholders::_2));
 }
 
 void registerFileRotatingHandler(
@@ -200,7 +746,41 @@ void registerFileRotatingHandler(
     int maxBackups,
     FileRotatingHandler::Formatter formatter)
 {
-    static FileRotatingHandler handler(path, maxSize, maxBackups, formatter);
+    FileRotatingHandler *handler = new FileRotatingHandler(path, maxSize, maxBackups, formatter);
     Logger::getInstance()->registerHandler(
-        std::bind(&FileRotatingHandler::write, &handler, std::placeholders::_1));
+        std::bind(&FileRotatingHandler::write, handler, std::placeholders::_1),
+        std::bind(&FileRotatingHandler::writeEmergency, handler, std::placeholders::_1, std::placeholders::_2));
+}
+
+void registerFileRotatingHandler(
+    const std::string &path,
+    size_t maxSize,
+    int maxBackups,
+    std::shared_ptr<LogEncoder> encoder)
+{
+    FileRotatingHandler *handler = new FileRotatingHandler(path, maxSize, maxBackups, std::move(encoder));
+    Logger::getInstance()->registerRawHandler(
+        std::bind(&FileRotatingHandler::write, handler, std::placeholders::_1));
+}
+
+void registerFileRotatingHandler(
+    const std::string &path,
+    size_t maxSize,
+    int maxBackups,
+    const FileRotatingHandler::Options &options)
+{
+    FileRotatingHandler *handler = new FileRotatingHandler(path, maxSize, maxBackups, options);
+    auto write = std::bind(&FileRotatingHandler::write, handler, std::placeholders::_1);
+    auto writeEmergency =
+        std::bind(&FileRotatingHandler::writeEmergency, handler, std::placeholders::_1, std::placeholders::_2);
+    if (options.rawMessages)
+    {
+        Logger::getInstance()->registerRawHandler(write, writeEmergency);
+    }
+    else
+    {
+        Logger::getInstance()->registerHandler(write, writeEmergency);
+    }
+    Logger::getInstance()->registerFlushHandler(std::bind(&FileRotatingHandler::flush, handler));
+    Logger::getInstance()->registerCloseHandler(std::bind(&FileRotatingHandler::close, handler));
 }
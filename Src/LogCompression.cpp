@@ -0,0 +1,201 @@
+#include "LogCompression.hpp"
+#include <cstdint>
+#include <cstring>
+
+// ========== Helpers ==========
+
+static const size_t MIN_MATCH = 4;
+static const size_t LAST_LITERALS = 5; // Format rule: a block ends with literals
+static const size_t MATCH_START_LIMIT = 12; // No match may start closer to the end
+static const size_t MAX_OFFSET = 65535;
+static const int HASH_BITS = 12;
+
+static uint32_t load32(const unsigned char *data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint32_t hashSequence(uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Lengths of 15 and more continue in extra bytes of 255 plus a remainder
+static unsigned char *writeLengthTail(unsigned char *out, size_t length)
+{
+    while (length >= 255)
+    {
+        *out++ = 255;
+        length -= 255;
+    }
+    *out++ = static_cast<unsigned char>(length);
+    return out;
+}
+
+static unsigned char *writeLiterals(unsigned char *out, unsigned char *token, const unsigned char *literals,
+                                    size_t length)
+{
+    if (length >= 15)
+    {
+        *token = 15 << 4;
+        out = writeLengthTail(out, length - 15);
+    }
+    else
+    {
+        *token = static_cast<unsigned char>(length << 4);
+    }
+    std::memcpy(out, literals, length);
+    return out + length;
+}
+
+static bool readLengthTail(const unsigned char *&in, const unsigned char *end, size_t &length)
+{
+    unsigned char byte;
+    do
+    {
+        if (in >= end)
+        {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+// ========== Codec ==========
+
+size_t lz4CompressBound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+size_t lz4Compress(const char *source, size_t size, char *destination)
+{
+    const unsigned char *src = reinterpret_cast<const unsigned char *>(source);
+    unsigned char *out = reinterpret_cast<unsigned char *>(destination);
+    size_t anchor = 0;
+
+    if (size > MATCH_START_LIMIT)
+    {
+        uint32_t table[1 << HASH_BITS] = {};
+        const size_t matchEndLimit = size - LAST_LITERALS;
+        const size_t matchStartLimit = size - MATCH_START_LIMIT;
+        size_t position = 0;
+
+        while (position <= matchStartLimit)
+        {
+            uint32_t sequence = load32(src + position);
+            uint32_t &slot = table[hashSequence(sequence)];
+            size_t candidate = slot;
+            slot = static_cast<uint32_t>(position);
+
+            if (candidate >= position || position - candidate > MAX_OFFSET || load32(src + candidate) != sequence)
+            {
+                // Step faster through data that does not compress
+                position += 1 + ((position - anchor) >> 6);
+                continue;
+            }
+
+            size_t length = MIN_MATCH;
+            while (position + length < matchEndLimit && src[candidate + length] == src[position + length])
+            {
+                ++length;
+            }
+            while (position > anchor && candidate > 0 && src[position - 1] == src[candidate - 1])
+            {
+                --position;
+                --candidate;
+                ++length;
+            }
+
+            unsigned char *token = out++;
+            out = writeLiterals(out, token, src + anchor, position - anchor);
+            size_t offset = position - candidate;
+            *out++ = static_cast<unsigned char>(offset);
+            *out++ = static_cast<unsigned char>(offset >> 8);
+            size_t matchLength = length - MIN_MATCH;
+            if (matchLength >= 15)
+            {
+                *token |= 15;
+                out = writeLengthTail(out, matchLength - 15);
+            }
+            else
+            {
+                *token |= static_cast<unsigned char>(matchLength);
+            }
+
+            position += length;
+            anchor = position;
+        }
+    }
+
+    unsigned char *token = out++;
+    out = writeLiterals(out, token, src + anchor, size - anchor);
+    return static_cast<size_t>(out - reinterpret_cast<unsigned char *>(destination));
+}
+
+bool lz4Decompress(const char *source, size_t size, char *destination, size_t rawSize)
+{
+    const unsigned char *in = reinterpret_cast<const unsigned char *>(source);
+    const unsigned char *end = in + size;
+    unsigned char *out = reinterpret_cast<unsigned char *>(destination);
+    size_t written = 0;
+
+    while (in < end)
+    {
+        unsigned char token = *in++;
+
+        size_t literals = token >> 4;
+        if (literals == 15 && !readLengthTail(in, end, literals))
+        {
+            return false;
+        }
+        if (literals > static_cast<size_t>(end - in) || literals > rawSize - written)
+        {
+            return false;
+        }
+        std::memcpy(out + written, in, literals);
+        in += literals;
+        written += literals;
+
+        if (in == end)
+        {
+            // The last sequence has no match
+            return written == rawSize;
+        }
+
+        if (end - in < 2)
+        {
+            return false;
+        }
+        size_t offset = in[0] | static_cast<size_t>(in[1]) << 8;
+        in += 2;
+        if (offset == 0 || offset > written)
+        {
+            return false;
+        }
+
+        size_t length = token & 15;
+        if (length == 15 && !readLengthTail(in, end, length))
+        {
+            return false;
+        }
+        length += MIN_MATCH;
+        if (length > rawSize - written)
+        {
+            return false;
+        }
+
+        // Byte by byte: the match may overlap the bytes it produces
+        const unsigned char *match = out + written - offset;
+        for (size_t i = 0; i < length; ++i)
+        {
+            out[written + i] = match[i];
+        }
+        written += length;
+    }
+    return false;
+}
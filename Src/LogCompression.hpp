@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Bundled LZ4-style block codec for compressed log frames
+ *
+ * Follows the LZ4 block format (token, literals, 16-bit offset, match
+ * length; last five bytes always literals). Compression is a single greedy pass with a small
+ * hash table: fast enough for the backend thread, and log text, being
+ * highly repetitive, still shrinks several times over.
+ */
+
+// Largest output lz4Compress() can produce for size input bytes
+size_t lz4CompressBound(size_t size);
+
+// Compress size bytes into dst (at least lz4CompressBound(size) bytes);
+// returns the compressed size
+size_t lz4Compress(const char *src, size_t size, char *dst);
+
+// Decompress exactly rawSize bytes; false on malformed input
+bool lz4Decompress(const char *src, size_t size, char *dst, size_t rawSize);
@@ -0,0 +1,481 @@
+#include "LogFraming.hpp"
+#include "LogCompression.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#define LOG4CPP_HAS_SSE42_CRC 1
+#endif
+
+// ========== CRC32C ==========
+
+// Reflected Castagnoli polynomial
+static const uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+
+struct Crc32cTable
+{
+    uint32_t entries[256];
+
+    Crc32cTable()
+    {
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc >> 1) ^ (CRC32C_POLYNOMIAL & (0u - (crc & 1)));
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+static uint32_t crc32cTable(uint32_t crc, const unsigned char *data, size_t size)
+{
+    static const Crc32cTable table;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#ifdef LOG4CPP_HAS_SSE42_CRC
+__attribute__((target("sse4.2"))) static uint32_t crc32cHardware(uint32_t crc, const unsigned char *data, size_t size)
+{
+#if defined(__x86_64__)
+    uint64_t wide = crc;
+    for (; size >= 8; size -= 8, data += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        wide = _mm_crc32_u64(wide, word);
+    }
+    crc = static_cast<uint32_t>(wide);
+#endif
+    for (; size > 0; --size, ++data)
+    {
+        crc = _mm_crc32_u8(crc, *data);
+    }
+    return crc;
+}
+#endif
+
+using Crc32cFunction = uint32_t (*)(uint32_t, const unsigned char *, size_t);
+
+static Crc32cFunction selectCrc32c()
+{
+#ifdef LOG4CPP_HAS_SSE42_CRC
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        return crc32cHardware;
+    }
+#endif
+    return crc32cTable;
+}
+
+uint32_t logCrc32c(const void *data, size_t size, uint32_t crc)
+{
+    static const Crc32cFunction implementation = selectCrc32c();
+    return ~implementation(~crc, static_cast<const unsigned char *>(data), size);
+}
+
+// ========== Framing ==========
+
+static void storeLittleEndian32(char *out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        out[i] = static_cast<char>(value >> (i * 8));
+    }
+}
+
+static uint32_t loadLittleEndian32(const char *in)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(in[i])) << (i * 8);
+    }
+    return value;
+}
+
+static void storeLittleEndian64(char *out, uint64_t value)
+{
+    storeLittleEndian32(out, static_cast<uint32_t>(value));
+    storeLittleEndian32(out + 4, static_cast<uint32_t>(value >> 32));
+}
+
+static uint64_t loadLittleEndian64(const char *in)
+{
+    return loadLittleEndian32(in) | static_cast<uint64_t>(loadLittleEndian32(in + 4)) << 32;
+}
+
+void makeLogFrameHeader(const char *payload, size_t size, char *header)
+{
+    std::memcpy(header, LOG4CPP_FRAME_MAGIC, 4);
+    storeLittleEndian32(header + 4, static_cast<uint32_t>(size));
+    uint32_t crc = logCrc32c(header + 4, 4);
+    storeLittleEndian32(header + 8, logCrc32c(payload, size, crc));
+}
+
+void appendCompressedLogFrame(const char *payload, size_t size, std::string &out)
+{
+    size_t start = out.size();
+    out.resize(start + LOG4CPP_COMPRESSED_FRAME_HEADER_SIZE + lz4CompressBound(size));
+    char *header = &out[start];
+    size_t length = lz4Compress(payload, size, header + LOG4CPP_COMPRESSED_FRAME_HEADER_SIZE);
+    if (length + LOG4CPP_COMPRESSED_FRAME_HEADER_SIZE >= size + LOG4CPP_FRAME_HEADER_SIZE)
+    {
+        out.resize(start + LOG4CPP_FRAME_HEADER_SIZE);
+        makeLogFrameHeader(payload, size, &out[start]);
+        out.append(payload, size);
+        return;
+    }
+
+    std::memcpy(header, LOG4CPP_COMPRESSED_FRAME_MAGIC, 4);
+    storeLittleEndian32(header + 4, static_cast<uint32_t>(length));
+    storeLittleEndian32(header + 8, static_cast<uint32_t>(size));
+    uint32_t crc = logCrc32c(header + 4, 8);
+    storeLittleEndian32(header + 12, logCrc32c(header + LOG4CPP_COMPRESSED_FRAME_HEADER_SIZE, length, crc));
+    out.resize(start + LOG4CPP_COMPRESSED_FRAME_HEADER_SIZE + length);
+}
+
+static bool isSyncMarker(const char *data)
+{
+    return std::memcmp(data, LOG4CPP_FRAME_MAGIC, 3) == 0 &&
+           (data[3] == LOG4CPP_FRAME_MAGIC[3] || data[3] == LOG4CPP_COMPRESSED_FRAME_MAGIC[3] ||
+            data[3] == LOG4CPP_FRAME_INDEX_MAGIC[3]);
+}
+
+bool isFramedLog(const char *data, size_t size)
+{
+    return size >= 4 && isSyncMarker(data);
+}
+
+// Verify the block at data and pass its payload on (seek tables are only
+// verified); returns the block size, or 0 if there is no intact block here
+static size_t readBlock(const char *data, size_t remaining, std::vector<char> &rawBuffer, bool &passedOn,
+                        const std::function<void(const char *payload, size_t size)> &onBlock)
+{
+    bool plain = remaining >= LOG4CPP_FRAME_HEADER_SIZE && std::memcmp(data, LOG4CPP_FRAME_MAGIC, 4) == 0;
+    bool seekTable = remaining >= LOG4CPP_FRAME_HEADER_SIZE && std::memcmp(data, LOG4CPP_FRAME_INDEX_MAGIC, 4) == 0;
+    if (plain || seekTable)
+    {
+        uint32_t length = loadLittleEndian32(data + 4);
+        if (length > LOG4CPP_FRAME_MAX_PAYLOAD || length > remaining - LOG4CPP_FRAME_HEADER_SIZE)
+        {
+            return 0;
+        }
+        const char *payload = data + LOG4CPP_FRAME_HEADER_SIZE;
+        if (logCrc32c(payload, length, logCrc32c(data + 4, 4)) != loadLittleEndian32(data + 8))
+        {
+            return 0;
+        }
+        passedOn = plain;
+        if (plain)
+        {
+            onBlock(payload, length);
+        }
+        return LOG4CPP_FRAME_HEADER_SIZE + length;
+    }
+
+    if (remaining >= LOG4CPP_COMPRESSED_FRAME_HEADER_SIZE &&
+        std::memcmp(data, LOG4CPP_COMPRESSED_FRAME_MAGIC, 4) == 0)
+    {
+        uint32_t length = loadLittleEndian32(data + 4);
+        uint32_t rawLength = loadLittleEndian32(data + 8);
+        if (rawLength > LOG4CPP_FRAME_MAX_PAYLOAD || length > remaining - LOG4CPP_COMPRESSED_FRAME_HEADER_SIZE)
+        {
+            return 0;
+        }
+        const char *payload = data + LOG4CPP_COMPRESSED_FRAME_HEADER_SIZE;
+        if (logCrc32c(payload, length, logCrc32c(data + 4, 8)) != loadLittleEndian32(data + 12))
+        {
+            return 0;
+        }
+        rawBuffer.resize(rawLength);
+        if (!lz4Decompress(payload, length, rawBuffer.data(), rawLength))
+        {
+            return 0;
+        }
+        passedOn = true;
+        onBlock(rawBuffer.data(), rawLength);
+        return LOG4CPP_COMPRESSED_FRAME_HEADER_SIZE + length;
+    }
+    return 0;
+}
+
+LogFrameScan scanLogFrames(const char *data, size_t size,
+                           const std::function<void(const char *payload, size_t size)> &onBlock)
+{
+    LogFrameScan scan{0, 0};
+    std::vector<char> rawBuffer;
+    size_t position = 0;
+    while (position < size)
+    {
+        bool passedOn = false;
+        size_t blockSize = readBlock(data + position, size - position, rawBuffer, passedOn, onBlock);
+        if (blockSize > 0)
+        {
+            scan.blocks += passedOn;
+            position += blockSize;
+            continue;
+        }
+
+        // Not a valid block here: resynchronize at the next sync marker
+        size_t skipTo = size;
+        for (size_t i = position + 1; i + 4 <= size; ++i)
+        {
+            if (data[i] == LOG4CPP_FRAME_MAGIC[0] && isSyncMarker(data + i))
+            {
+                skipTo = i;
+                break;
+            }
+        }
+        scan.skippedBytes += skipTo - position;
+        position = skipTo;
+    }
+    return scan;
+}
+
+// ========== Seek Table ==========
+
+void appendLogFrameIndex(const std::vector<LogFrameIndexEntry> &entries, uint64_t from, std::string &out)
+{
+    size_t payloadSize = 8 + 4 + entries.size() * LOG4CPP_FRAME_INDEX_ENTRY_SIZE + 4;
+    size_t start = out.size();
+    out.resize(start + LOG4CPP_FRAME_HEADER_SIZE + payloadSize);
+    char *payload = &out[start + LOG4CPP_FRAME_HEADER_SIZE];
+
+    char *field = payload;
+    storeLittleEndian64(field, from);
+    storeLittleEndian32(field + 8, static_cast<uint32_t>(entries.size()));
+    field += 12;
+    for (const LogFrameIndexEntry &entry : entries)
+    {
+        storeLittleEndian64(field, entry.offset);
+        storeLittleEndian32(field + 8, entry.size);
+        storeLittleEndian64(field + 12, static_cast<uint64_t>(entry.oldestNs));
+        storeLittleEndian64(field + 20, static_cast<uint64_t>(entry.newestNs));
+        storeLittleEndian32(field + 28, entry.levelMask);
+        field += LOG4CPP_FRAME_INDEX_ENTRY_SIZE;
+    }
+    storeLittleEndian32(field, static_cast<uint32_t>(LOG4CPP_FRAME_HEADER_SIZE + payloadSize));
+
+    makeLogFrameHeader(payload, payloadSize, &out[start]);
+    std::memcpy(&out[start], LOG4CPP_FRAME_INDEX_MAGIC, 4);
+}
+
+// Parse the seek table that ends at data + end
+static bool readIndexBefore(const char *data, size_t end, std::vector<LogFrameIndexEntry> &entries, size_t &from)
+{
+    if (end < 4)
+    {
+        return false;
+    }
+    size_t blockSize = loadLittleEndian32(data + end - 4);
+    if (blockSize < LOG4CPP_FRAME_HEADER_SIZE + 16 || blockSize > end)
+    {
+        return false;
+    }
+    const char *block = data + end - blockSize;
+    size_t length = blockSize - LOG4CPP_FRAME_HEADER_SIZE;
+    const char *payload = block + LOG4CPP_FRAME_HEADER_SIZE;
+    if (std::memcmp(block, LOG4CPP_FRAME_INDEX_MAGIC, 4) != 0 || loadLittleEndian32(block + 4) != length ||
+        logCrc32c(payload, length, logCrc32c(block + 4, 4)) != loadLittleEndian32(block + 8))
+    {
+        return false;
+    }
+
+    uint64_t regionStart = loadLittleEndian64(payload);
+    size_t count = loadLittleEndian32(payload + 8);
+    size_t regionEnd = end - blockSize;
+    if (length != 16 + count * LOG4CPP_FRAME_INDEX_ENTRY_SIZE || regionStart > regionEnd)
+    {
+        return false;
+    }
+
+    entries.resize(count);
+    const char *field = payload + 12;
+    for (LogFrameIndexEntry &entry : entries)
+    {
+        entry.offset = loadLittleEndian64(field);
+        entry.size = loadLittleEndian32(field + 8);
+        entry.oldestNs = static_cast<int64_t>(loadLittleEndian64(field + 12));
+        entry.newestNs = static_cast<int64_t>(loadLittleEndian64(field + 20));
+        entry.levelMask = loadLittleEndian32(field + 28);
+        field += LOG4CPP_FRAME_INDEX_ENTRY_SIZE;
+        if (entry.offset < regionStart || entry.offset > regionEnd || entry.size > regionEnd - entry.offset)
+        {
+            return false;
+        }
+    }
+    from = static_cast<size_t>(regionStart);
+    return true;
+}
+
+LogFrameIndex readLogFrameIndex(const char *data, size_t size)
+{
+    // Follow the chain of tables backwards, one per writing session
+    std::vector<std::vector<LogFrameIndexEntry>> tables;
+    size_t end = size;
+    while (end > 0)
+    {
+        std::vector<LogFrameIndexEntry> entries;
+        size_t from;
+        if (!readIndexBefore(data, end, entries, from))
+        {
+            break;
+        }
+        tables.push_back(std::move(entries));
+        end = from;
+    }
+
+    LogFrameIndex index;
+    index.unindexedSize = end;
+    for (auto table = tables.rbegin(); table != tables.rend(); ++table)
+    {
+        index.entries.insert(index.entries.end(), table->begin(), table->end());
+    }
+    return index;
+}
+
+// Payloads of one region, collected by a worker for in-order delivery
+struct RegionOutput
+{
+    std::string payloads;
+    std::vector<size_t> sizes;
+    LogFrameScan scan;
+};
+
+LogFrameScan queryLogFrames(const char *data, size_t size, const LogFrameQuery &query,
+                            const std::function<void(const char *payload, size_t size)> &onBlock,
+                            unsigned threads)
+{
+    LogFrameIndex index = readLogFrameIndex(data, size);
+
+    struct Region
+    {
+        size_t offset;
+        size_t size;
+    };
+    std::vector<Region> regions;
+    if (index.unindexedSize > 0)
+    {
+        regions.push_back({0, index.unindexedSize});
+    }
+    for (const LogFrameIndexEntry &entry : index.entries)
+    {
+        if (entry.newestNs >= query.fromNs && entry.oldestNs <= query.toNs && (entry.levelMask & query.levelMask) != 0)
+        {
+            regions.push_back({static_cast<size_t>(entry.offset), entry.size});
+        }
+    }
+
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t workers = std::min<size_t>(threads, regions.size());
+
+    // Workers pull region indices from a shared counter; a region is only
+    // scanned once it is within `window` of the next one to deliver, so
+    // memory holds a few regions per worker, not the result
+    size_t window = std::max<size_t>(1, workers * 4);
+    std::vector<RegionOutput> outputs(window);
+    std::vector<bool> ready(window, false);
+    std::atomic<size_t> nextRegion{0};
+    size_t delivered = 0;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    auto work = [&]()
+    {
+        for (size_t i = nextRegion++; i < regions.size(); i = nextRegion++)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]
+                             { return stopping || i < delivered + window; });
+                if (stopping)
+                {
+                    return;
+                }
+            }
+            const Region &region = regions[i];
+            RegionOutput &output = outputs[i % window];
+            output.scan = scanLogFrames(data + region.offset, region.size,
+                                        [&output](const char *payload, size_t payloadSize)
+                                        {
+                                            output.payloads.append(payload, payloadSize);
+                                            output.sizes.push_back(payloadSize);
+                                        });
+            std::lock_guard<std::mutex> lock(mutex);
+            ready[i % window] = true;
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t worker = 0; worker < workers; ++worker)
+    {
+        pool.emplace_back(work);
+    }
+    auto stopPool = [&]()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        for (std::thread &thread : pool)
+        {
+            thread.join();
+        }
+    };
+
+    // Deliver on the calling thread, in region order
+    LogFrameScan total{0, 0};
+    try
+    {
+        while (delivered < regions.size())
+        {
+            RegionOutput &output = outputs[delivered % window];
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]
+                             { return ready[delivered % window]; });
+            }
+            const char *payload = output.payloads.data();
+            for (size_t payloadSize : output.sizes)
+            {
+                onBlock(payload, payloadSize);
+                payload += payloadSize;
+            }
+            total.blocks += output.scan.blocks;
+            total.skippedBytes += output.scan.skippedBytes;
+            output.payloads.clear();
+            output.sizes.clear();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            ready[delivered % window] = false;
+            ++delivered;
+            changed.notify_all();
+        }
+    }
+    catch (...)
+    {
+        stopPool();
+        throw;
+    }
+    stopPool();
+    return total;
+}
@@ -0,0 +1,102 @@
+#include "LogMemoryResource.hpp"
+#include <cstdint>
+#include <new>
+
+// ========== Default Resource ==========
+
+class NewDeleteLogMemoryResource : public LogMemoryResource
+{
+protected:
+    void *doAllocate(size_t bytes, size_t alignment) override
+    {
+        if (alignment <= alignof(std::max_align_t))
+        {
+            return ::operator new(bytes);
+        }
+
+        // C++14 has no aligned operator new: over-allocate and stash the
+        // original pointer just before the aligned block
+        void *raw = ::operator new(bytes + alignment + sizeof(void *));
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw) + sizeof(void *);
+        uintptr_t aligned = (start + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        reinterpret_cast<void **>(aligned)[-1] = raw;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    void doDeallocate(void *ptr, size_t, size_t alignment) override
+    {
+        if (alignment <= alignof(std::max_align_t))
+        {
+            ::operator delete(ptr);
+            return;
+        }
+        ::operator delete(static_cast<void **>(ptr)[-1]);
+    }
+};
+
+LogMemoryResource *defaultLogMemoryResource()
+{
+    static NewDeleteLogMemoryResource resource;
+    return &resource;
+}
+
+// ========== MonotonicLogMemoryResource Implementation ==========
+
+MonotonicLogMemoryResource::MonotonicLogMemoryResource(LogMemoryResource *upstreamResource)
+    : MonotonicLogMemoryResource(nullptr, 0, upstreamResource)
+{
+}
+
+MonotonicLogMemoryResource::MonotonicLogMemoryResource(void *buffer, size_t size, LogMemoryResource *upstreamResource)
+    : upstream(upstreamResource), initialBuffer(static_cast<char *>(buffer)), initialSize(size),
+      current(initialBuffer), remaining(size), nextChunkSize(4096)
+{
+}
+
+MonotonicLogMemoryResource::~MonotonicLogMemoryResource()
+{
+    release();
+}
+
+void MonotonicLogMemoryResource::release()
+{
+    for (const Chunk &chunk : chunks)
+    {
+        upstream->deallocate(chunk.memory, chunk.size, alignof(std::max_align_t));
+    }
+    chunks.clear();
+    current = initialBuffer;
+    remaining = initialSize;
+    nextChunkSize = 4096;
+}
+
+void *MonotonicLogMemoryResource::doAllocate(size_t bytes, size_t alignment)
+{
+    uintptr_t start = reinterpret_cast<uintptr_t>(current);
+    size_t padding = static_cast<size_t>(((start + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1)) - start);
+
+    if (current == nullptr || padding + bytes > remaining)
+    {
+        // Grow geometrically so a burst of allocations needs few chunks
+        size_t chunkSize = nextChunkSize;
+        while (chunkSize < bytes + alignment)
+        {
+            chunkSize *= 2;
+        }
+        // Room for the record first, so push_back cannot throw and leak the chunk
+        chunks.reserve(chunks.size() + 1);
+        void *memory = upstream->allocate(chunkSize, alignof(std::max_align_t));
+        chunks.push_back(Chunk{memory, chunkSize});
+        nextChunkSize = chunkSize * 2;
+
+        current = static_cast<char *>(memory);
+        remaining = chunkSize;
+        start = reinterpret_cast<uintptr_t>(current);
+        padding = static_cast<size_t>(((start + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1)) - start);
+    }
+
+    char *result = current + padding;
+    current = result + bytes;
+    remaining -= padding + bytes;
+    return result;
+}
@@ -0,0 +1,418 @@
+#include "LogRedactor.hpp"
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define LOG4CPP_HAS_SSE2_PREFILTER 1
+#endif
+
+// ========== Helpers ==========
+
+enum PatternKind
+{
+    PATTERN_LITERAL,
+    PATTERN_KEY_VALUE,
+    PATTERN_TOKEN
+};
+
+struct RedactionPattern
+{
+    std::string text;
+    PatternKind kind;
+};
+
+// A stretch of text to mask, found before any masking is applied
+struct MaskRange
+{
+    size_t begin;
+    size_t end;
+    bool card; // Mask only digits, keeping the last four
+};
+
+static const int ALPHABET = 256;
+static const int MAX_PREFILTER_BYTES = 16;
+static const size_t MAX_PENDING_RANGES = 32;
+
+static bool isDigit(unsigned char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static bool isValueDelimiter(unsigned char c)
+{
+    return std::isspace(c) || std::strchr("&,;\"')]}<>", c) != nullptr;
+}
+
+static bool isTokenCharacter(unsigned char c)
+{
+    return std::isalnum(c) || std::strchr("-_./+=", c) != nullptr;
+}
+
+// Card number starting at begin: 13-19 digits, single space or dash between
+// groups, Luhn-valid. Sets end past the last digit.
+static bool findCardNumber(const unsigned char *text, size_t begin, size_t length, size_t &end)
+{
+    int digits[19];
+    int count = 0;
+    size_t position = begin;
+    while (position < length)
+    {
+        if (isDigit(text[position]))
+        {
+            if (count == 19)
+            {
+                return false; // Longer than any card number
+            }
+            digits[count++] = text[position] - '0';
+            end = ++position;
+        }
+        else if ((text[position] == ' ' || text[position] == '-') && position + 1 < length &&
+                 isDigit(text[position + 1]) && position > begin)
+        {
+            ++position;
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (count < 13)
+    {
+        return false;
+    }
+
+    int sum = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        int digit = digits[count - 1 - i];
+        if (i % 2 == 1)
+        {
+            digit *= 2;
+            if (digit > 9)
+            {
+                digit -= 9;
+            }
+        }
+        sum += digit;
+    }
+    return sum % 10 == 0;
+}
+
+// ========== LogRedactor::Impl Definition ==========
+
+class LogRedactor::Impl
+{
+public:
+    bool ignoreCase;
+    char mask;
+    bool cardNumbers;
+    std::vector<RedactionPattern> patterns;
+
+    // ---- Compiled matcher ----
+    bool compiled;
+    unsigned char fold[ALPHABET];   // Byte to automaton input (case folding)
+    std::vector<uint32_t> next;     // DFA transitions, ALPHABET per state
+    std::vector<int32_t> output;    // Pattern ending in the state, or -1
+    std::vector<int32_t> outputLink; // Nearest state on the failure chain with an output, or -1
+    bool startByte[ALPHABET];       // Bytes that can begin a match
+#ifdef LOG4CPP_HAS_SSE2_PREFILTER
+    __m128i prefilterBytes[MAX_PREFILTER_BYTES]; // Each start byte, broadcast
+#endif
+    int prefilterCount;
+    bool prefilterDigits; // Digits are tested as a range
+    bool prefilterVector; // Start bytes fit the SIMD prefilter
+
+    Impl(bool caseless, char maskCharacter)
+        : ignoreCase(caseless), mask(maskCharacter), cardNumbers(false), compiled(false), prefilterCount(0),
+          prefilterDigits(false), prefilterVector(false)
+    {
+    }
+
+    void build()
+    {
+        for (int c = 0; c < ALPHABET; ++c)
+        {
+            fold[c] = static_cast<unsigned char>(ignoreCase ? std::tolower(c) : c);
+        }
+
+        // Trie of all patterns
+        std::vector<std::vector<int32_t>> children(1, std::vector<int32_t>(ALPHABET, -1));
+        output.assign(1, -1);
+        for (size_t p = 0; p < patterns.size(); ++p)
+        {
+            int32_t state = 0;
+            for (unsigned char c : patterns[p].text)
+            {
+                unsigned char input = fold[c];
+                if (children[state][input] < 0)
+                {
+                    children[state][input] = static_cast<int32_t>(children.size());
+                    children.emplace_back(ALPHABET, -1);
+                    output.push_back(-1);
+                }
+                state = children[state][input];
+            }
+            output[state] = static_cast<int32_t>(p);
+        }
+
+        // Breadth-first: failure links, then every missing transition
+        // follows the failure link, which turns the trie into a DFA
+        size_t stateCount = children.size();
+        next.assign(stateCount * ALPHABET, 0);
+        outputLink.assign(stateCount, -1);
+        std::vector<int32_t> failure(stateCount, 0);
+        std::queue<int32_t> pending;
+        for (int c = 0; c < ALPHABET; ++c)
+        {
+            int32_t child = children[0][c];
+            if (child > 0)
+            {
+                next[c] = static_cast<uint32_t>(child);
+                pending.push(child);
+            }
+        }
+        while (!pending.empty())
+        {
+            int32_t state = pending.front();
+            pending.pop();
+            int32_t fallback = failure[state];
+            outputLink[state] = output[fallback] >= 0 ? fallback : outputLink[fallback];
+            for (int c = 0; c < ALPHABET; ++c)
+            {
+                int32_t child = children[state][c];
+                uint32_t viaFailure = next[static_cast<size_t>(fallback) * ALPHABET + c];
+                if (child > 0)
+                {
+                    failure[child] = static_cast<int32_t>(viaFailure);
+                    next[static_cast<size_t>(state) * ALPHABET + c] = static_cast<uint32_t>(child);
+                    pending.push(child);
+                }
+                else
+                {
+                    next[static_cast<size_t>(state) * ALPHABET + c] = viaFailure;
+                }
+            }
+        }
+
+        // Prefilter: every byte that leaves the root state
+        int distinct = 0;
+        prefilterCount = 0;
+        prefilterDigits = cardNumbers;
+        for (int c = 0; c < ALPHABET; ++c)
+        {
+            startByte[c] = next[fold[c]] != 0 || (cardNumbers && isDigit(static_cast<unsigned char>(c)));
+            if (startByte[c] && !(prefilterDigits && isDigit(static_cast<unsigned char>(c))))
+            {
+#ifdef LOG4CPP_HAS_SSE2_PREFILTER
+                if (distinct < MAX_PREFILTER_BYTES)
+                {
+                    prefilterBytes[prefilterCount++] = _mm_set1_epi8(static_cast<char>(c));
+                }
+#endif
+                ++distinct;
+            }
+        }
+        prefilterVector = distinct <= MAX_PREFILTER_BYTES;
+        compiled = true;
+    }
+
+    // Bit i set if text[base + i] can begin a match, for the (up to) 16
+    // bytes starting at base
+    uint32_t candidates(const unsigned char *text, size_t base, size_t length) const
+    {
+#ifdef LOG4CPP_HAS_SSE2_PREFILTER
+        if (prefilterVector && base + 16 <= length)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + base));
+            __m128i hits = _mm_setzero_si128();
+            for (int i = 0; i < prefilterCount; ++i)
+            {
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, prefilterBytes[i]));
+            }
+            if (prefilterDigits)
+            {
+                // c - '0' <= 9 as unsigned bytes
+                __m128i offset = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(9)), offset));
+            }
+            return static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        }
+#endif
+        uint32_t found = 0;
+        size_t end = base + 16 < length ? base + 16 : length;
+        for (size_t position = base; position < end; ++position)
+        {
+            found |= static_cast<uint32_t>(startByte[text[position]]) << (position - base);
+        }
+        return found;
+    }
+
+    // Range masked for pattern p matched just before `end`
+    bool patternRange(const unsigned char *text, size_t length, int32_t p, size_t end, MaskRange &range) const
+    {
+        const RedactionPattern &pattern = patterns[static_cast<size_t>(p)];
+        range.card = false;
+        if (pattern.kind == PATTERN_LITERAL)
+        {
+            range.begin = end - pattern.text.size();
+            range.end = end;
+            return true;
+        }
+
+        size_t position = end;
+        while (position < length &&
+               (pattern.kind == PATTERN_KEY_VALUE ? !isValueDelimiter(text[position]) : isTokenCharacter(text[position])))
+        {
+            ++position;
+        }
+        range.begin = end;
+        range.end = position;
+        return position > end;
+    }
+
+    void apply(char *text, const MaskRange *ranges, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const MaskRange &range = ranges[i];
+            if (!range.card)
+            {
+                std::memset(text + range.begin, mask, range.end - range.begin);
+                continue;
+            }
+
+            // Keep the last four digits readable
+            int keep = 4;
+            for (size_t position = range.end; position-- > range.begin;)
+            {
+                if (isDigit(static_cast<unsigned char>(text[position])))
+                {
+                    if (keep > 0)
+                    {
+                        --keep;
+                    }
+                    else
+                    {
+                        text[position] = mask;
+                    }
+                }
+            }
+        }
+    }
+};
+
+// ========== LogRedactor Implementation ==========
+
+LogRedactor::LogRedactor(bool ignoreCase, char mask)
+    : impl(new Impl(ignoreCase, mask))
+{
+}
+
+LogRedactor::~LogRedactor() = default;
+
+void LogRedactor::addLiteral(const std::string &literal)
+{
+    if (!literal.empty())
+    {
+        impl->patterns.push_back({literal, PATTERN_LITERAL});
+    }
+}
+
+void LogRedactor::addKeyValue(const std::string &key)
+{
+    if (!key.empty())
+    {
+        impl->patterns.push_back({key, PATTERN_KEY_VALUE});
+    }
+}
+
+void LogRedactor::addToken(const std::string &prefix)
+{
+    if (!prefix.empty())
+    {
+        impl->patterns.push_back({prefix, PATTERN_TOKEN});
+    }
+}
+
+void LogRedactor::addCardNumbers()
+{
+    impl->cardNumbers = true;
+}
+
+void LogRedactor::compile()
+{
+    impl->build();
+}
+
+size_t LogRedactor::redact(char *text, size_t length) const
+{
+    const Impl &matcher = *impl;
+    if (!matcher.compiled)
+    {
+        return 0;
+    }
+
+    // Ranges are collected first and masked afterwards, so overlapping
+    // patterns all see the original text
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(text);
+    MaskRange ranges[MAX_PENDING_RANGES];
+    size_t rangeCount = 0;
+    size_t matches = 0;
+    auto addRange = [&](const MaskRange &range)
+    {
+        if (rangeCount == MAX_PENDING_RANGES)
+        {
+            matcher.apply(text, ranges, rangeCount);
+            rangeCount = 0;
+        }
+        ranges[rangeCount++] = range;
+        ++matches;
+    };
+
+    size_t resume = 0; // Bytes before this were consumed by an automaton walk
+    for (size_t base = 0; base < length; base += 16)
+    {
+        for (uint32_t found = matcher.candidates(bytes, base, length); found != 0; found &= found - 1)
+        {
+            size_t position = base + static_cast<size_t>(__builtin_ctz(found));
+            if (position < resume)
+            {
+                continue;
+            }
+
+            // Run the automaton until it falls back to the root, where the
+            // prefilter takes over again. Card numbers are looked for at every
+            // byte of the walk, since one may start right after a match.
+            uint32_t state = 0;
+            size_t cursor = position;
+            do
+            {
+                size_t cardEnd;
+                if (matcher.cardNumbers && isDigit(bytes[cursor]) && (cursor == 0 || !isDigit(bytes[cursor - 1])) &&
+                    findCardNumber(bytes, cursor, length, cardEnd))
+                {
+                    addRange({cursor, cardEnd, true});
+                }
+                state = matcher.next[static_cast<size_t>(state) * ALPHABET + matcher.fold[bytes[cursor]]];
+                ++cursor;
+                int32_t hit = matcher.output[state] >= 0 ? static_cast<int32_t>(state) : matcher.outputLink[state];
+                for (; hit >= 0; hit = matcher.outputLink[hit])
+                {
+                    MaskRange range;
+                    if (matcher.patternRange(bytes, length, matcher.output[hit], cursor, range))
+                    {
+                        addRange(range);
+                    }
+                }
+            } while (cursor < length && state != 0);
+            resume = cursor;
+        }
+    }
+
+    matcher.apply(text, ranges, rangeCount);
+    return matches;
+}
@@ -0,0 +1,148 @@
+#include "LogSanitizer.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ========== Helpers ==========
+
+static const char REPLACEMENT_CHARACTER[] = "\xEF\xBF\xBD"; // U+FFFD
+
+// Plain printable ASCII or tab: the only bytes that never need a look
+static bool isPlain(unsigned char c)
+{
+    return (c >= 0x20 && c < 0x7F) || c == '\t';
+}
+
+// First byte at or after position that is not plain
+static size_t nextSuspect(const unsigned char *text, size_t position, size_t size)
+{
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(0x20);
+    const __m128i del = _mm_set1_epi8(0x7F);
+    const __m128i tab = _mm_set1_epi8('\t');
+    for (; position + 16 <= size; position += 16)
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + position));
+        // Signed compare: control bytes and every byte >= 0x80 are below ' '
+        __m128i suspect = _mm_or_si128(_mm_cmplt_epi8(chunk, space), _mm_cmpeq_epi8(chunk, del));
+        suspect = _mm_andnot_si128(_mm_cmpeq_epi8(chunk, tab), suspect);
+        int found = _mm_movemask_epi8(suspect);
+        if (found != 0)
+        {
+            return position + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(found)));
+        }
+    }
+#endif
+    while (position < size && isPlain(text[position]))
+    {
+        ++position;
+    }
+    return position;
+}
+
+// Length of the well-formed UTF-8 sequence at text (RFC 3629: no overlong
+// forms, surrogates or code points above U+10FFFF); 0 if ill-formed
+static size_t utf8SequenceLength(const unsigned char *text, size_t available)
+{
+    unsigned char lead = text[0];
+    size_t length;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+        length = 2;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+        length = 3;
+        low = lead == 0xE0 ? 0xA0 : 0x80;
+        high = lead == 0xED ? 0x9F : 0xBF;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+        length = 4;
+        low = lead == 0xF0 ? 0x90 : 0x80;
+        high = lead == 0xF4 ? 0x8F : 0xBF;
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (available < length || text[1] < low || text[1] > high)
+    {
+        return 0;
+    }
+    for (size_t i = 2; i < length; ++i)
+    {
+        if (text[i] < 0x80 || text[i] > 0xBF)
+        {
+            return 0;
+        }
+    }
+    return length;
+}
+
+static void appendEscape(std::string &out, unsigned char c)
+{
+    static const char hex[] = "0123456789abcdef";
+    switch (c)
+    {
+    case '\n':
+        out += "\\n";
+        return;
+    case '\r':
+        out += "\\r";
+        return;
+    }
+    char escape[4] = {'\\', 'x', hex[c >> 4], hex[c & 0xF]};
+    out.append(escape, sizeof(escape));
+}
+
+// ========== Sanitization ==========
+
+bool sanitizeLogText(const char *text, size_t size, std::string &out)
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(text);
+    bool modified = false;
+    size_t copied = 0; // text[0, copied) is already in out
+    size_t position = nextSuspect(bytes, 0, size);
+    while (position < size)
+    {
+        unsigned char c = bytes[position];
+        if (c >= 0x80)
+        {
+            size_t length = utf8SequenceLength(bytes + position, size - position);
+            if (length > 0)
+            {
+                position = nextSuspect(bytes, position + length, size);
+                continue;
+            }
+        }
+
+        if (!modified)
+        {
+            out.clear();
+            out.reserve(size + 16);
+            modified = true;
+        }
+        out.append(text + copied, position - copied);
+        if (c >= 0x80)
+        {
+            out += REPLACEMENT_CHARACTER;
+        }
+        else
+        {
+            appendEscape(out, c);
+        }
+        copied = ++position;
+        position = nextSuspect(bytes, position, size);
+    }
+
+    if (modified)
+    {
+        out.append(text + copied, size - copied);
+    }
+    return modified;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Message sanitization for line-oriented sinks
+ *
+ * Escapes line breaks (\n, \r) and other control bytes (as \xHH; tab is
+ * kept) and replaces invalid UTF-8 with U+FFFD, so a message can neither
+ * start a forged log line nor feed binary garbage to parsers. Clean text,
+ * checked 16 bytes at a time, is left alone and never copied.
+ */
+
+// Returns false if text needs no changes; otherwise writes the sanitized
+// text to out and returns true
+bool sanitizeLogText(const char *text, size_t size, std::string &out);
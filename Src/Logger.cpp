@@ -1,101 +1,2538 @@
 #include "Logger.hpp"
+#include "LogRealtime.hpp"
+#include "LogRedactor.hpp"
+#include "LogSpan.hpp"
+#include "LogSanitizer.hpp"
+#include "NumaTopology.hpp"
+#include "RecordSlab.hpp"
+#include "SignalQueue.hpp"
+#include "SpillFile.hpp"
+#include "CacheLine.hpp"
 #include <iostream>
 #include <chrono>
-#include <iomanip>
 #include <vector>
 #include <mutex>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// ========== Helpers ==========
+
+static int64_t currentTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+static void appendDecimal(std::string &out, int value)
+{
+    char digits[16];
+    int length = std::snprintf(digits, sizeof(digits), "%d", value);
+    out.append(digits, static_cast<size_t>(length));
+}
+
+/**
+ * TimestampFormatter - Renders "YYYY-MM-DD HH:MM:SS.uuuuuu" into a fixed buffer
+ *
+ * The date and time of day are only recomputed with localtime_r() when the
+ * second changes, so consecutive messages just rewrite the microseconds.
+ */
+class TimestampFormatter
+{
+public:
+    LogStringRef format(int64_t timestampNs)
+    {
+        int64_t seconds = timestampNs / 1000000000;
+        int64_t nanos = timestampNs % 1000000000;
+        if (nanos < 0)
+        {
+            seconds -= 1;
+            nanos += 1000000000;
+        }
+
+        if (seconds != cachedSecond)
+        {
+            std::time_t time = static_cast<std::time_t>(seconds);
+            std::tm local;
+            localtime_r(&time, &local);
+            dateLength = std::strftime(text, sizeof(text) - 8, "%Y-%m-%d %H:%M:%S", &local);
+            cachedSecond = seconds;
+        }
+
+        int64_t micros = nanos / 1000;
+        text[dateLength] = '.';
+        for (size_t i = dateLength + 6; i > dateLength; --i)
+        {
+            text[i] = static_cast<char>('0' + micros % 10);
+            micros /= 10;
+        }
+        text[dateLength + 7] = '\0';
+        return LogStringRef(text, dateLength + 7);
+    }
+
+private:
+    int64_t cachedSecond = INT64_MIN;
+    size_t dateLength = 0;
+    char text[40];
+};
+
+// Per rendering thread: the logging thread in synchronous mode, a backend
+// thread in asynchronous mode
+static thread_local TimestampFormatter timestampFormatter;
+
+// ========== Thread Identity ==========
+
+// Thread ids and the process id are cached; fork() bumps the generation so
+// the child refreshes them lazily instead of reporting the parent's
+static std::atomic<uint32_t> forkGeneration(1);
+static std::atomic<int> cachedProcessId(0);
+
+struct ThreadIdentity
+{
+    uint32_t generation = 0;
+    uint64_t threadId = 0;
+    bool named = false;
+    size_t nameLength = 0;
+    char name[LOG4CPP_THREAD_NAME_CAPACITY];
+};
+
+static thread_local ThreadIdentity threadIdentity;
+
+static void renderThreadIdAsName(ThreadIdentity &identity)
+{
+    int length = std::snprintf(identity.name, sizeof(identity.name), "%llu",
+                               static_cast<unsigned long long>(identity.threadId));
+    identity.nameLength = static_cast<size_t>(length);
+}
+
+static const ThreadIdentity &currentThreadIdentity()
+{
+    ThreadIdentity &identity = threadIdentity;
+    uint32_t generation = forkGeneration.load(std::memory_order_relaxed);
+    if (identity.generation != generation)
+    {
+        identity.threadId = static_cast<uint64_t>(syscall(SYS_gettid));
+        identity.generation = generation;
+        if (!identity.named)
+        {
+            renderThreadIdAsName(identity);
+        }
+    }
+    return identity;
+}
+
+// Needs no logger: the name is picked up when the thread first logs
+static void nameCurrentThread(const std::string &name)
+{
+    ThreadIdentity &identity = threadIdentity;
+    currentThreadIdentity();
+    if (name.empty())
+    {
+        identity.named = false;
+        renderThreadIdAsName(identity);
+    }
+    else
+    {
+        identity.named = true;
+        identity.nameLength = std::min(name.size(), sizeof(identity.name) - 1);
+        std::memcpy(identity.name, name.data(), identity.nameLength);
+        identity.name[identity.nameLength] = '\0';
+    }
+}
+
+static int currentProcessId()
+{
+    int pid = cachedProcessId.load(std::memory_order_relaxed);
+    if (pid == 0)
+    {
+        pid = static_cast<int>(getpid());
+        cachedProcessId.store(pid, std::memory_order_relaxed);
+    }
+    return pid;
+}
+
+// Slab owned by the calling thread; retired when the thread exits so the
+// backend can free it once everything in it has been written
+struct ThreadSlab
+{
+    std::shared_ptr<RecordSlab> slab;
+
+    ~ThreadSlab()
+    {
+        if (slab)
+        {
+            slab->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+static thread_local ThreadSlab threadSlab;
+
+// Reusable per-thread formatting stream (see LogStream::Lease)
+struct ThreadStream
+{
+    LogStream stream;
+    bool inUse = false;
+};
+
+static thread_local ThreadStream threadStream;
+
+// ========== Event Rendering ==========
+
+// Scratch space for turning an event's bytes into a message and fields,
+// reused by the thread that renders (the logging thread in synchronous
+// mode, the backend thread in asynchronous mode)
+struct EventRendering
+{
+    std::string payload;
+    std::string message;
+    std::vector<LogField> fields;
+};
+
+static thread_local EventRendering eventRendering;
+
+static void appendFieldText(std::string &out, const LogField &field)
+{
+    char digits[32];
+    int length = 0;
+    switch (field.type)
+    {
+    case LogFieldType::INT:
+        length = std::snprintf(digits, sizeof(digits), "%lld", static_cast<long long>(field.intValue));
+        break;
+    case LogFieldType::UINT:
+        length = std::snprintf(digits, sizeof(digits), "%llu", static_cast<unsigned long long>(field.uintValue));
+        break;
+    case LogFieldType::DOUBLE:
+        // Same precision as streaming a double into a log message
+        length = std::snprintf(digits, sizeof(digits), "%g", field.doubleValue);
+        break;
+    case LogFieldType::BOOL:
+        out += field.boolValue ? "true" : "false";
+        return;
+    case LogFieldType::STRING:
+        out.append(field.stringValue.data(), field.stringValue.size());
+        return;
+    }
+    out.append(digits, static_cast<size_t>(length));
+}
+
+// Decode an event into "Name field=value ..." and typed fields
+static const EventRendering &renderEvent(const LogEventSchema &schema, const void *data)
+{
+    EventRendering &rendering = eventRendering;
+    rendering.payload.assign(static_cast<const char *>(data), schema.size);
+    rendering.fields.resize(schema.fieldCount);
+    rendering.message.assign(schema.name);
+
+    for (size_t i = 0; i < schema.fieldCount; ++i)
+    {
+        const LogEventField &description = schema.fields[i];
+        LogField &field = rendering.fields[i];
+        field.key = LogStringRef(description.name);
+        field.type = description.type;
+        field.stringValue = LogStringRef();
+        description.load(&rendering.payload[description.offset], field);
+
+        rendering.message += ' ';
+        rendering.message.append(field.key.data(), field.key.size());
+        rendering.message += '=';
+        appendFieldText(rendering.message, field);
+    }
+    return rendering;
+}
+
+// Message and fields of an event for dispatch. If rendering runs out of
+// memory, the message is just the event's name, copied because dispatch
+// may mask it in place.
+struct RenderedEvent
+{
+    LogStringRef message;
+    const LogField *fields;
+    size_t fieldCount;
+};
+
+static RenderedEvent renderEventForDispatch(const LogEventSchema &schema, const void *data)
+{
+    try
+    {
+        const EventRendering &rendering = renderEvent(schema, data);
+        return RenderedEvent{LogStringRef(rendering.message), rendering.fields.data(), rendering.fields.size()};
+    }
+    catch (const std::bad_alloc &)
+    {
+        static thread_local char name[64];
+        int length = std::snprintf(name, sizeof(name), "%s", schema.name);
+        return RenderedEvent{LogStringRef(name, std::min(static_cast<size_t>(length), sizeof(name) - 1)), nullptr, 0};
+    }
+}
+
+// ========== Real-Time Rendering ==========
+
+template <typename T>
+static T readRealtimeValue(const char *&cursor)
+{
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+// Stream the arguments encoded by LogRealtimeEncoder, as the logging
+// templates would have
+static void renderRealtime(const char *payload, size_t size, std::ostream &out)
+{
+    const char *cursor = payload;
+    const char *end = payload + size;
+    while (cursor < end)
+    {
+        LogRealtimeTag tag = static_cast<LogRealtimeTag>(*cursor++);
+        switch (tag)
+        {
+        case REALTIME_INT:
+            out << readRealtimeValue<int64_t>(cursor);
+            break;
+        case REALTIME_UINT:
+            out << readRealtimeValue<uint64_t>(cursor);
+            break;
+        case REALTIME_DOUBLE:
+            out << readRealtimeValue<double>(cursor);
+            break;
+        case REALTIME_BOOL:
+            out << (readRealtimeValue<uint8_t>(cursor) != 0);
+            break;
+        case REALTIME_CHAR:
+            out << readRealtimeValue<char>(cursor);
+            break;
+        case REALTIME_POINTER:
+            out << reinterpret_cast<const void *>(readRealtimeValue<uintptr_t>(cursor));
+            break;
+        case REALTIME_STRING:
+        {
+            uint16_t length = readRealtimeValue<uint16_t>(cursor);
+            out.write(cursor, length);
+            cursor += length;
+            break;
+        }
+        default:
+            return;
+        }
+    }
+}
+
+// ========== Span Timing ==========
+
+/**
+ * TickClock - Converts logReadTicks() values to wall-clock nanoseconds
+ *
+ * The tick rate is measured against the system clock over the whole time
+ * since the clock was created, so it gets more precise the longer the
+ * process runs. The conversion is re-anchored at most once a second; the
+ * two calibrations are double-buffered so readers never lock.
+ */
+class TickClock
+{
+public:
+    TickClock() : active(0), refreshing(false)
+    {
+        originTicks = logReadTicks();
+        originNs = currentTimeNs();
+        store(0, originTicks, originNs, 0.0);
+    }
+
+    int64_t toNs(uint64_t ticks)
+    {
+        while (true)
+        {
+            const Calibration &calibration = slots[active.load(std::memory_order_acquire)];
+            uint64_t anchorTicks = calibration.ticks.load(std::memory_order_relaxed);
+            double nsPerTick = calibration.nsPerTick.load(std::memory_order_relaxed);
+            // Negative for a span that began before the latest anchor
+            int64_t elapsed = static_cast<int64_t>(ticks - anchorTicks);
+            if (nsPerTick == 0.0 ||
+                elapsed > static_cast<int64_t>(calibration.refreshTicks.load(std::memory_order_relaxed)))
+            {
+                if (refresh())
+                {
+                    continue;
+                }
+                if (nsPerTick == 0.0)
+                {
+                    // Nothing to fall back on before the first calibration
+                    std::this_thread::yield();
+                    continue;
+                }
+                // Another thread is recalibrating: the last calibration will do
+            }
+            return calibration.ns.load(std::memory_order_relaxed) + static_cast<int64_t>(elapsed * nsPerTick);
+        }
+    }
+
+    uint64_t durationNs(uint64_t beginTicks, uint64_t endTicks) const
+    {
+        double nsPerTick = slots[active.load(std::memory_order_acquire)].nsPerTick.load(std::memory_order_relaxed);
+        return endTicks > beginTicks ? static_cast<uint64_t>((endTicks - beginTicks) * nsPerTick) : 0;
+    }
+
+private:
+    struct Calibration
+    {
+        std::atomic<uint64_t> ticks;
+        std::atomic<int64_t> ns;
+        std::atomic<double> nsPerTick;
+        std::atomic<uint64_t> refreshTicks; // Re-anchor once this many ticks have passed
+    };
+
+    static const int64_t MIN_BASELINE_NS = 100000;    // First estimate of the tick rate
+    static const int64_t REFRESH_INTERVAL_NS = 1000000000;
+
+    uint64_t originTicks;
+    int64_t originNs;
+    Calibration slots[2];
+    std::atomic<int> active;
+    std::atomic<bool> refreshing;
+
+    void store(int slot, uint64_t ticks, int64_t ns, double nsPerTick)
+    {
+        slots[slot].ticks.store(ticks, std::memory_order_relaxed);
+        slots[slot].ns.store(ns, std::memory_order_relaxed);
+        slots[slot].nsPerTick.store(nsPerTick, std::memory_order_relaxed);
+        slots[slot].refreshTicks.store(
+            nsPerTick > 0.0 ? static_cast<uint64_t>(REFRESH_INTERVAL_NS / nsPerTick) : 0, std::memory_order_relaxed);
+    }
+
+    // Re-anchor the calibration; false if another thread is already at it
+    bool refresh()
+    {
+        if (refreshing.exchange(true, std::memory_order_acquire))
+        {
+            return false;
+        }
+        uint64_t ticks = logReadTicks();
+        int64_t ns = currentTimeNs();
+        while (ns - originNs < MIN_BASELINE_NS)
+        {
+            ticks = logReadTicks();
+            ns = currentTimeNs();
+        }
+        int next = 1 - active.load(std::memory_order_relaxed);
+        store(next, ticks, ns, static_cast<double>(ns - originNs) / static_cast<double>(ticks - originTicks));
+        active.store(next, std::memory_order_release);
+        refreshing.store(false, std::memory_order_release);
+        return true;
+    }
+};
+
+// Message and fields of a span entry, in the rendering thread's own storage
+// (dispatch may mask both in place)
+static RenderedEvent renderSpan(const char *name, uint64_t durationNs)
+{
+    struct SpanRendering
+    {
+        char message[160];
+        char name[96];
+        LogField fields[2];
+    };
+    static thread_local SpanRendering rendering;
+
+    int nameLength = std::snprintf(rendering.name, sizeof(rendering.name), "%s", name);
+    int length = std::snprintf(rendering.message, sizeof(rendering.message), "%s took %.3fus", rendering.name,
+                               static_cast<double>(durationNs) / 1000.0);
+    rendering.fields[0].key = LogStringRef("span", 4);
+    rendering.fields[0].type = LogFieldType::STRING;
+    rendering.fields[0].stringValue =
+        LogStringRef(rendering.name, std::min(static_cast<size_t>(nameLength), sizeof(rendering.name) - 1));
+    rendering.fields[1].key = LogStringRef("durationNs", 10);
+    rendering.fields[1].type = LogFieldType::UINT;
+    rendering.fields[1].uintValue = durationNs;
+    return RenderedEvent{LogStringRef(rendering.message, std::min(static_cast<size_t>(length), sizeof(rendering.message) - 1)),
+                         rendering.fields, 2};
+}
+
+// Entries signal handlers can queue before the next drain
+static const size_t SIGNAL_QUEUE_CAPACITY = 128;
+
+// ========== Emergency Output ==========
+
+// Longest line the out-of-memory path writes, newline included
+static const size_t EMERGENCY_LINE_CAPACITY = 4096;
+
+// Bounded appends into a fixed buffer, for the out-of-memory path
+class EmergencyLine
+{
+public:
+    EmergencyLine(char *buffer, size_t capacity) : text(buffer), size(0), capacity(capacity) {}
+
+    void append(LogStringRef part)
+    {
+        size_t length = std::min(part.size(), capacity - size);
+        std::memcpy(text + size, part.data(), length);
+        size += length;
+    }
+
+    // Control bytes become '?' so the line stays one line
+    void appendMessage(LogStringRef message)
+    {
+        size_t length = std::min(message.size(), capacity - size);
+        for (size_t i = 0; i < length; ++i)
+        {
+            unsigned char c = static_cast<unsigned char>(message.data()[i]);
+            text[size + i] = (c < 0x20 && c != '\t') || c == 0x7F ? '?' : static_cast<char>(c);
+        }
+        size += length;
+    }
+
+    // End the line, marking a cut with "..."
+    LogStringRef finish()
+    {
+        if (size == capacity)
+        {
+            size = std::min(size, capacity - 4);
+            std::memcpy(text + size, "...", 3);
+            size += 3;
+        }
+        text[size++] = '\n';
+        return LogStringRef(text, size);
+    }
+
+private:
+    char *text;
+    size_t size;
+    size_t capacity;
+};
+
+// The default console layout, built without allocating
+static LogStringRef formatEmergencyLine(const LogEntry &entry, char *buffer, size_t capacity)
+{
+    char lineNumber[16];
+    int lineNumberLength = std::snprintf(lineNumber, sizeof(lineNumber), "%d", entry.lineNumber);
+
+    EmergencyLine line(buffer, capacity);
+    line.append("[");
+    line.append(entry.timestamp);
+    line.append("][");
+    line.append(LogStringRef(logLevelInfo(entry.severity).padded, LOG4CPP_LEVEL_WIDTH));
+    line.append("][");
+    line.append(entry.component);
+    line.append("][");
+    line.append(entry.function);
+    line.append(":");
+    line.append(LogStringRef(lineNumber, static_cast<size_t>(lineNumberLength)));
+    line.append("] ");
+    line.appendMessage(entry.message);
+    return line.finish();
+}
+
+// Write to a file descriptor, ignoring errors: nothing else can be done
+static void writeDescriptor(int fd, LogStringRef text)
+{
+    const char *data = text.data();
+    size_t remaining = text.size();
+    while (remaining > 0)
+    {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return;
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+}
+
+// ========== Handler Watchdog ==========
+
+// Entries an isolated handler can fall behind by before new ones are dropped
+static const size_t ISOLATED_QUEUE_CAPACITY = 4096;
+
+// When stopping an isolated handler's thread, it is given up on once it has
+// written nothing for this many watchdog thresholds (at least a second)
+static const uint64_t ISOLATED_STOP_THRESHOLDS = 10;
+static const uint64_t ISOLATED_STOP_MIN_NS = 1000000000;
+
+// An entry with its own copy of every string, for an isolated handler
+struct QueuedEntry
+{
+    LogEntry entry;
+    std::string text;
+    std::vector<LogField> fields;
+};
+
+static std::unique_ptr<QueuedEntry> copyEntry(const LogEntry &entry)
+{
+    std::unique_ptr<QueuedEntry> copy(new QueuedEntry());
+    copy->entry = entry;
+    copy->fields.assign(entry.fields, entry.fields + entry.fieldCount);
+    copy->entry.fields = copy->fields.data();
+
+    LogStringRef *strings[] = {&copy->entry.timestamp, &copy->entry.level, &copy->entry.component,
+                               &copy->entry.function, &copy->entry.message, &copy->entry.threadName,
+                               &copy->entry.file};
+    size_t total = 0;
+    for (LogStringRef *text : strings)
+    {
+        total += text->size() + 1;
+    }
+    for (const LogField &field : copy->fields)
+    {
+        total += field.key.size() + field.stringValue.size() + 2;
+    }
+
+    // Reserved up front, so the references stay valid while appending
+    std::string &buffer = copy->text;
+    buffer.reserve(total);
+    auto keep = [&buffer](LogStringRef &text)
+    {
+        size_t offset = buffer.size();
+        buffer.append(text.data(), text.size());
+        buffer += '\0';
+        text = LogStringRef(buffer.data() + offset, text.size());
+    };
+    for (LogStringRef *text : strings)
+    {
+        keep(*text);
+    }
+    for (LogField &field : copy->fields)
+    {
+        keep(field.key);
+        if (field.type == LogFieldType::STRING)
+        {
+            keep(field.stringValue);
+        }
+    }
+    return copy;
+}
+
+/**
+ * HandlerMonitor - Call counters of one registered handler, and the queue
+ * and thread it runs from once the watchdog has isolated it
+ */
+class HandlerMonitor
+{
+public:
+    HandlerMonitor()
+        : state(LogHandlerState::DIRECT), calls(0), slowestNs(0), queued(0), dropped(0), retired(false),
+          running(false), completed(0), threadLost(false)
+    {
+    }
+
+    std::atomic<LogHandlerState> state;
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> slowestNs;
+    std::atomic<size_t> queued; // Waiting or being written
+    std::atomic<uint64_t> dropped;
+
+    // One writer at a time: the dispatcher, or once isolated the handler's thread
+    void recordCall(uint64_t ns)
+    {
+        calls.store(calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (ns > slowestNs.load(std::memory_order_relaxed))
+        {
+            slowestNs.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    // Call the handler from a thread of its own from now on. The thread
+    // exits once retired and drained; stop() joins it. Caller holds the
+    // dispatcher's lock.
+    static void isolate(const std::shared_ptr<HandlerMonitor> &monitor, const OutputHandler &handler)
+    {
+        if (monitor->worker.joinable())
+        {
+            // Still holding the handle of a thread lost in a fork
+            throw std::runtime_error("log handler thread unavailable");
+        }
+        {
+            std::lock_guard<std::mutex> lock(monitor->mutex);
+            monitor->retired = false;
+            monitor->running = true;
+        }
+        try
+        {
+            monitor->worker = std::thread(&HandlerMonitor::run, monitor, handler);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(monitor->mutex);
+            monitor->running = false;
+            throw;
+        }
+        monitor->state.store(LogHandlerState::ISOLATED, std::memory_order_relaxed);
+    }
+
+    // Let the thread write out its queue, then join it, so the handler's
+    // objects are not in use once this returns. A thread that writes nothing
+    // for `stallNs` is reported, its queue dropped, its handler disabled and
+    // the thread left behind. Caller holds the dispatcher's lock. Returns
+    // false if the thread was lost in a fork and its handle must be kept.
+    bool stop(uint64_t stallNs)
+    {
+        if (!worker.joinable())
+        {
+            return true;
+        }
+        if (threadLost)
+        {
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        retired = true;
+        wake.notify_one();
+        while (running)
+        {
+            uint64_t seen = completed;
+            idle.wait_for(lock, std::chrono::nanoseconds(stallNs), [this, seen]
+                          { return !running || completed != seen; });
+            if (running && completed == seen)
+            {
+                dropped.fetch_add(queue.size(), std::memory_order_relaxed);
+                queued.fetch_sub(queue.size(), std::memory_order_relaxed);
+                queue.clear();
+                lock.unlock();
+                worker.detach();
+                state.store(LogHandlerState::DISABLED, std::memory_order_relaxed);
+                std::cerr << "Isolated log handler still blocked after " << stallNs / 1000000
+                          << "ms; disabled and its thread left behind\n";
+                return true;
+            }
+        }
+        retired = false;
+        lock.unlock();
+        worker.join();
+        // Called directly again; the watchdog isolates it anew if need be
+        state.store(LogHandlerState::DIRECT, std::memory_order_relaxed);
+        return true;
+    }
+
+    // In a forked child the thread does not exist: call the handler directly
+    // and drop what was queued for it. Only async-signal-safe work here.
+    void forgetThread()
+    {
+        if (worker.joinable())
+        {
+            threadLost = true;
+            state.store(LogHandlerState::DIRECT, std::memory_order_relaxed);
+        }
+    }
+
+    void enqueue(const LogEntry &entry)
+    {
+        try
+        {
+            std::unique_ptr<QueuedEntry> copy = copyEntry(entry);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.size() >= ISOLATED_QUEUE_CAPACITY)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            queue.push_back(std::move(copy));
+            queued.fetch_add(1, std::memory_order_relaxed);
+        }
+        catch (const std::bad_alloc &)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        wake.notify_one();
+    }
+
+    // The handler was unregistered: let its thread finish the queue and exit
+    void retire()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        retired = true;
+        wake.notify_one();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle; // An entry was written, or the thread is exiting
+    std::deque<std::unique_ptr<QueuedEntry>> queue;
+    bool retired;
+    bool running;       // The thread has not exited yet
+    uint64_t completed; // Entries written by the thread
+    std::thread worker; // Guarded by the dispatcher's lock
+    bool threadLost;    // Set in a forked child
+
+    void run(OutputHandler handler)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            wake.wait(lock, [this]
+                      { return !queue.empty() || retired; });
+            if (queue.empty())
+            {
+                running = false;
+                idle.notify_all();
+                return;
+            }
+            std::unique_ptr<QueuedEntry> next = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+
+            auto start = std::chrono::steady_clock::now();
+            try
+            {
+                handler(next->entry);
+            }
+            catch (const std::bad_alloc &)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            recordCall(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+            next.reset();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            lock.lock();
+            ++completed;
+            idle.notify_all();
+        }
+    }
+};
+
+// ========== Memory Resources ==========
+
+// Logger-wide resource (nullptr: defaultLogMemoryResource())
+static std::atomic<LogMemoryResource *> loggerMemoryResource(nullptr);
+
+// Per-thread override (nullptr: logger-wide resource)
+static thread_local LogMemoryResource *threadMemoryResource = nullptr;
+
+static LogMemoryResource *activeMemoryResource()
+{
+    if (threadMemoryResource != nullptr)
+    {
+        return threadMemoryResource;
+    }
+    LogMemoryResource *resource = loggerMemoryResource.load(std::memory_order_acquire);
+    return resource != nullptr ? resource : defaultLogMemoryResource();
+}
 
 // ========== Logger::Impl Definition ==========
 
-class Logger::Impl
-{
-public:
-    std::string componentName;
-    LogLevel currentLevel;
-    std::vector<OutputHandler> handlers;
-    mutable std::mutex handlersMutex;
+class Logger::Impl : public CacheLineAligned
+{
+public:
+    struct RegisteredHandler
+    {
+        OutputHandler handler;
+        bool raw; // Skips message sanitization
+        EmergencyHandler emergency; // Out-of-memory fallback; stderr if empty
+        std::shared_ptr<HandlerMonitor> monitor;
+    };
+    using HandlerList = std::vector<RegisteredHandler>;
+
+    // ---- Hot, read-mostly state: read by every logging call ----
+    // Kept on its own cache line so lock and counter traffic below never
+    // invalidates the line every thread reads to filter a message.
+
+    // Bit (1 << level) set for every level that is logged
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::atomic<uint32_t> enabledLevels;
+    std::atomic<LogLevel> currentLevel;
+    std::atomic<bool> asyncEnabled;
+    // Copy-on-write handler list, replaced under handlersMutex
+    std::atomic<const HandlerList *> handlerSnapshot;
+    std::atomic<const LogRedactor *> redactor;
+    std::atomic<bool> sanitizeMessages;
+    std::string componentName;
+
+    // ---- Write-heavy state: mutexes and counters, one cache line each ----
+
+    // Serializes registration; owns the current and all retired snapshots
+    // (registration is rare, so retired lists are kept until destruction)
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::mutex handlersMutex;
+    std::vector<std::unique_ptr<const HandlerList>> handlerLists;
+    // Redactors ever installed, kept like the handler lists; redactor is
+    // the one dispatch() applies
+    std::vector<std::shared_ptr<const LogRedactor>> redactors;
+
+    // Serializes handler calls so handlers never run concurrently; also
+    // guards the flush handlers, which run at the end of each batch, the
+    // close handlers, which run once when the handlers are removed, and the
+    // emergency line
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::mutex dispatchMutex;
+    std::vector<FlushHandler> flushHandlers;
+    std::vector<FlushHandler> closeHandlers;
+    // Preallocated line for entries a handler could not write for lack of memory
+    char emergencyLine[EMERGENCY_LINE_CAPACITY];
+    // Handler watchdog settings (0: off)
+    uint64_t watchdogThresholdNs;
+    // Monitors whose handler has been given a thread, including handlers
+    // unregistered since; guarded by dispatchMutex
+    std::vector<std::shared_ptr<HandlerMonitor>> isolatedMonitors;
+    bool watchdogIsolates;
+
+    // One drain thread: a single one for the logger or, with
+    // AsyncLogOptions::backendPerNode, one per NUMA node, pinned to the node
+    // and draining the slabs placed on it
+    struct Backend : public CacheLineAligned
+    {
+        explicit Backend(int numaNode) : node(numaNode), completedCycles(0), wakeSeen(0), depth(0) {}
+
+        alignas(LOG4CPP_CACHE_LINE_SIZE) int node; // -1: not tied to a node
+        std::thread thread;
+        uint64_t completedCycles; // Guarded by backendMutex
+        uint64_t wakeSeen;        // Guarded by backendMutex
+        // Fullest of its slabs, as a fraction of the capacity, when its last drain began
+        std::atomic<double> depth;
+
+        // Scratch state, reused across drains
+        std::vector<std::shared_ptr<RecordSlab>> drainSnapshot;
+        std::vector<uint64_t> drainLimits;
+    };
+
+    // Asynchronous mode: producers fill their own RecordSlab, the backends
+    // drain the slabs and call the handlers. backends[0] also drains the
+    // signal queue, the spill file and slabs no other backend takes.
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::mutex asyncControlMutex;
+    AsyncLogOptions asyncOptions;
+    std::vector<std::unique_ptr<Backend>> backends;
+
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::mutex slabsMutex;
+    std::vector<std::shared_ptr<RecordSlab>> slabs;
+
+    // From LogWarmupOptions, set before initialize() publishes the logger:
+    // every slab is prefaulted, and locked in RAM
+    bool prefaultSlabs;
+    bool lockSlabs;
+
+    // Overflow queue on disk (AsyncLogOptions::spillPath); set up before
+    // asyncEnabled is published, torn down after the backend has stopped
+    SpillFile spillFile;
+    std::atomic<bool> spillEnabled;
+
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::mutex backendMutex;
+    std::condition_variable backendWake;
+    std::condition_variable backendCycleDone;
+    bool backendRunning;
+    uint64_t wakeGeneration; // Bumped to wake every backend
+
+    // Handlers took at least pressureLatencyUs per entry in the last drain
+    // of backends[0] that wrote any
+    bool slowWrites;
+
+    // Adaptive verbosity: getLogLevel() is currentLevel; while underPressure
+    // the threshold in enabledLevels is raised to pressureLevel. Both
+    // writers, setLogLevel() and the backend, recompute it under levelMutex.
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::mutex levelMutex;
+    bool underPressure;
+    LogLevel pressureLevel;
+
+    // Entries from signal handlers; drained by whichever thread gets
+    // signalDrainMutex first (the backend, or synchronous writers)
+    alignas(LOG4CPP_CACHE_LINE_SIZE) SignalQueue signalQueue;
+    std::mutex signalDrainMutex;
+
+    // LOG_CPP_REALTIME entries that could not be queued
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::atomic<uint64_t> realtimeDropped;
+
+    // Converts LOG_CPP_SPAN ticks to timestamps
+    TickClock tickClock;
+
+    // Created by the parent of a fork(); initialize() replaces it
+    bool inherited;
+
+    Impl(const std::string &name, LogLevel level)
+        : enabledLevels(levelMask(level)), currentLevel(level), asyncEnabled(false), handlerSnapshot(nullptr),
+          redactor(nullptr), sanitizeMessages(false), componentName(name), watchdogThresholdNs(0),
+          watchdogIsolates(true), prefaultSlabs(false), lockSlabs(false), spillEnabled(false), backendRunning(false), wakeGeneration(0),
+          slowWrites(false), underPressure(false), pressureLevel(LogLevel::TRACE), signalQueue(SIGNAL_QUEUE_CAPACITY),
+          realtimeDropped(0), inherited(false)
+    {
+        publishHandlers(HandlerList());
+
+        static std::once_flag forkHooks;
+        std::call_once(forkHooks, []
+                       { pthread_atfork(nullptr, nullptr, &Impl::afterForkInChild); });
+    }
+
+    // The child of fork() has only the forking thread: refresh the cached
+    // ids, log synchronously and call isolated handlers directly. Any other
+    // lock of the logger (or of a handler) may have been held by a thread
+    // that does not exist in the child, so the child calls initialize()
+    // again, which replaces this logger, before it logs. Only
+    // async-signal-safe work here.
+    static void afterForkInChild()
+    {
+        cachedProcessId.store(static_cast<int>(getpid()), std::memory_order_relaxed);
+        forkGeneration.fetch_add(1, std::memory_order_relaxed);
+        threadSlab.slab.reset(); // Still referenced by the parent's logger
+        if (Logger::instance != nullptr)
+        {
+            Impl &impl = *Logger::instance->impl;
+            impl.inherited = true;
+            impl.asyncEnabled.store(false, std::memory_order_relaxed);
+            for (const auto &monitor : impl.isolatedMonitors)
+            {
+                monitor->forgetThread();
+            }
+            // A handler that forks holds it; no thread is left to unlock it
+            new (&impl.dispatchMutex) std::mutex();
+        }
+    }
+
+    ~Impl()
+    {
+        stopAsync();
+    }
+
+    // Mask with a bit for every level at or above `level`
+    static uint32_t levelMask(LogLevel level)
+    {
+        return ~((1u << static_cast<unsigned>(level)) - 1u);
+    }
+
+    bool isEnabled(LogLevel level) const
+    {
+        return (enabledLevels.load(std::memory_order_relaxed) >> static_cast<unsigned>(level)) & 1u;
+    }
+
+    void setLogLevel(LogLevel level)
+    {
+        std::lock_guard<std::mutex> lock(levelMutex);
+        currentLevel.store(level, std::memory_order_relaxed);
+        enabledLevels.store(levelMask(effectiveLevel()), std::memory_order_relaxed);
+    }
+
+    // The configured level, raised while under pressure (levelMutex held)
+    LogLevel effectiveLevel() const
+    {
+        LogLevel level = currentLevel.load(std::memory_order_relaxed);
+        return underPressure && pressureLevel > level ? pressureLevel : level;
+    }
+
+    // ---- Handler registration (copy-on-write) ----
+
+    void publishHandlers(HandlerList list)
+    {
+        handlerLists.emplace_back(new HandlerList(std::move(list)));
+        handlerSnapshot.store(handlerLists.back().get(), std::memory_order_release);
+    }
+
+    void registerHandler(OutputHandler handler, bool raw, EmergencyHandler emergency)
+    {
+        std::lock_guard<std::mutex> lock(handlersMutex);
+        HandlerList list(*handlerSnapshot.load(std::memory_order_relaxed));
+        list.push_back(
+            RegisteredHandler{std::move(handler), raw, std::move(emergency), std::make_shared<HandlerMonitor>()});
+        publishHandlers(std::move(list));
+    }
+
+    // Stop the threads of isolated handlers that are being unregistered
+    void retireHandlers()
+    {
+        for (const auto &registered : *handlerSnapshot.load(std::memory_order_relaxed))
+        {
+            registered.monitor->retire();
+        }
+    }
+
+    void clearHandlers()
+    {
+        std::lock_guard<std::mutex> lock(handlersMutex);
+        retireHandlers();
+        publishHandlers(HandlerList());
+        dropFlushHandlers();
+    }
+
+    void setHandler(OutputHandler handler)
+    {
+        std::lock_guard<std::mutex> lock(handlersMutex);
+        retireHandlers();
+        publishHandlers(HandlerList{
+            RegisteredHandler{std::move(handler), false, EmergencyHandler(), std::make_shared<HandlerMonitor>()}});
+        dropFlushHandlers();
+    }
+
+    // ---- Handler watchdog ----
+
+    void setHandlerWatchdog(uint32_t thresholdUs, bool isolate)
+    {
+        std::lock_guard<std::mutex> lock(dispatchMutex);
+        watchdogThresholdNs = static_cast<uint64_t>(thresholdUs) * 1000;
+        watchdogIsolates = isolate;
+    }
+
+    std::vector<LogHandlerStats> getHandlerStats() const
+    {
+        std::vector<LogHandlerStats> stats;
+        for (const auto &registered : *handlerSnapshot.load(std::memory_order_acquire))
+        {
+            const HandlerMonitor &monitor = *registered.monitor;
+            stats.push_back(LogHandlerStats{monitor.state.load(std::memory_order_relaxed),
+                                            monitor.calls.load(std::memory_order_relaxed),
+                                            monitor.slowestNs.load(std::memory_order_relaxed),
+                                            monitor.queued.load(std::memory_order_relaxed),
+                                            monitor.dropped.load(std::memory_order_relaxed)});
+        }
+        return stats;
+    }
+
+    // Call a handler, timed while the watchdog is on. Caller holds dispatchMutex.
+    void callHandler(const RegisteredHandler &registered, size_t index, const LogEntry &entry)
+    {
+        HandlerMonitor &monitor = *registered.monitor;
+        if (watchdogThresholdNs == 0)
+        {
+            registered.handler(entry);
+            monitor.recordCall(0);
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        registered.handler(entry);
+        uint64_t elapsedNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        monitor.recordCall(elapsedNs);
+        if (elapsedNs < watchdogThresholdNs)
+        {
+            return;
+        }
+
+        bool isolated = false;
+        if (watchdogIsolates)
+        {
+            try
+            {
+                HandlerMonitor::isolate(registered.monitor, registered.handler);
+                isolated = true;
+                if (std::find(isolatedMonitors.begin(), isolatedMonitors.end(), registered.monitor) ==
+                    isolatedMonitors.end())
+                {
+                    isolatedMonitors.push_back(registered.monitor);
+                }
+            }
+            catch (const std::exception &)
+            {
+                // No thread to be had: disable it instead
+            }
+        }
+        if (!isolated)
+        {
+            monitor.state.store(LogHandlerState::DISABLED, std::memory_order_relaxed);
+        }
+        std::cerr << "Log handler " << index << " took " << elapsedNs / 1000 << "us; "
+                  << (isolated ? "moved to a thread of its own" : "disabled") << "\n";
+    }
+
+    // Write out and join the threads of isolated handlers, before the
+    // objects their handlers use are torn down (stopAsync(), exit)
+    void stopIsolatedHandlers()
+    {
+        std::lock_guard<std::mutex> lock(dispatchMutex);
+        uint64_t stallNs = std::max(watchdogThresholdNs * ISOLATED_STOP_THRESHOLDS, ISOLATED_STOP_MIN_NS);
+        isolatedMonitors.erase(std::remove_if(isolatedMonitors.begin(), isolatedMonitors.end(),
+                                              [stallNs](const std::shared_ptr<HandlerMonitor> &monitor)
+                                              { return monitor->stop(stallNs); }),
+                               isolatedMonitors.end());
+    }
+
+    void setRedactor(std::shared_ptr<const LogRedactor> replacement)
+    {
+        std::lock_guard<std::mutex> lock(handlersMutex);
+        redactor.store(replacement.get(), std::memory_order_release);
+        if (replacement)
+        {
+            redactors.push_back(std::move(replacement));
+        }
+    }
+
+    // Messages and string fields always sit in buffers the logger owns (the
+    // formatting stream, a slab record, an event's payload copy or the spill
+    // read buffer), so they are masked in place, once for all handlers
+    void redact(LogStringRef message, const LogField *fields, size_t fieldCount) const
+    {
+        const LogRedactor *active = redactor.load(std::memory_order_acquire);
+        if (active == nullptr)
+        {
+            return;
+        }
+        active->redact(const_cast<char *>(message.data()), message.size());
+        for (size_t i = 0; i < fieldCount; ++i)
+        {
+            if (fields[i].type == LogFieldType::STRING)
+            {
+                active->redact(const_cast<char *>(fields[i].stringValue.data()), fields[i].stringValue.size());
+            }
+        }
+    }
+
+    void registerFlushHandler(FlushHandler handler)
+    {
+        std::lock_guard<std::mutex> lock(dispatchMutex);
+        flushHandlers.push_back(std::move(handler));
+    }
+
+    // Caller holds dispatchMutex
+    void callFlushHandlers()
+    {
+        for (const auto &handler : flushHandlers)
+        {
+            handler();
+        }
+    }
+
+    void registerCloseHandler(FlushHandler handler)
+    {
+        std::lock_guard<std::mutex> lock(dispatchMutex);
+        closeHandlers.push_back(std::move(handler));
+    }
+
+    // Caller holds dispatchMutex
+    void callCloseHandlers()
+    {
+        for (const auto &handler : closeHandlers)
+        {
+            handler();
+        }
+        closeHandlers.clear();
+    }
+
+    // Flush handlers belong to the output handlers being removed: give them
+    // a last call so nothing buffered is lost, then drop them
+    void dropFlushHandlers()
+    {
+        std::lock_guard<std::mutex> lock(dispatchMutex);
+        callFlushHandlers();
+        flushHandlers.clear();
+        callCloseHandlers();
+    }
+
+    // At exit the handlers stay registered (later messages still reach
+    // them), but their output is finished
+    void closeOutputs()
+    {
+        std::lock_guard<std::mutex> lock(dispatchMutex);
+        callFlushHandlers();
+        callCloseHandlers();
+    }
+
+    // Drain queued records and finish handler output when the process exits
+    static void installExitHook()
+    {
+        static std::once_flag exitHook;
+        std::call_once(exitHook, []
+                       { std::atexit([]
+                                     {
+                                         if (Logger::instance != nullptr)
+                                         {
+                                             Logger::instance->stopAsync();
+                                             Logger::instance->impl->stopIsolatedHandlers();
+                                             Logger::instance->impl->drainSignalRecords(true);
+                                             Logger::instance->impl->closeOutputs();
+                                         } }); });
+    }
+
+    // Level filtering happens in the Logger templates before formatting.
+    // The location's strings must be static unless copyFunction is set, in
+    // which case an asynchronous record copies the function name.
+    void writeLog(LogLevel level, const LogSourceLocation &location, bool copyFunction, LogStringRef message)
+    {
+        int64_t timestampNs = currentTimeNs();
+        if (asyncEnabled.load(std::memory_order_acquire))
+        {
+            try
+            {
+                enqueue(level, timestampNs, location, copyFunction, message);
+                return;
+            }
+            catch (const std::bad_alloc &)
+            {
+                // No memory for this thread's slab or the record's text:
+                // write it from here, which needs no allocation
+            }
+        }
+
+        dispatchFromThisThread(level, timestampNs, location, message);
+    }
+
+    void dispatchFromThisThread(LogLevel level, int64_t timestampNs, const LogSourceLocation &location,
+                                LogStringRef message)
+    {
+        if (!signalQueue.empty())
+        {
+            drainSignalRecords(true);
+        }
+        const ThreadIdentity &identity = currentThreadIdentity();
+        dispatch(level, timestampNs, LogStringRef(location.file), LogStringRef(location.function, location.functionLength),
+                 location.line, message, identity.threadId, LogStringRef(identity.name, identity.nameLength), nullptr, 0,
+                 true);
+    }
+
+    // Build the entry and call all registered handlers (thread-safe). A
+    // synchronous write is a batch of its own, so it also ends the batch.
+    void dispatch(LogLevel level, int64_t timestampNs, LogStringRef file, LogStringRef function, int lineNumber,
+                  LogStringRef message, uint64_t threadId, LogStringRef threadName,
+                  const LogField *fields, size_t fieldCount, bool endOfBatch)
+    {
+        const HandlerList *handlers = handlerSnapshot.load(std::memory_order_acquire);
+        if (handlers->empty())
+        {
+            return;
+        }
+        redact(message, fields, fieldCount);
+
+        // Line-safe copy of the message for all but raw handlers
+        static thread_local std::string sanitized;
+        LogStringRef clean = message;
+        bool sanitizeFailed = false;
+        try
+        {
+            if (sanitizeMessages.load(std::memory_order_relaxed) &&
+                sanitizeLogText(message.data(), message.size(), sanitized))
+            {
+                clean = LogStringRef(sanitized);
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            sanitizeFailed = true; // Emergency lines are single-line anyway
+        }
+
+        LogEntry entry{
+            timestampFormatter.format(timestampNs),
+            LogStringRef(logLevelInfo(level).name, logLevelInfo(level).nameLength),
+            LogStringRef(componentName),
+            function,
+            lineNumber,
+            clean,
+            threadId,
+            threadName,
+            currentProcessId(),
+            file,
+            level,
+            timestampNs,
+            fields,
+            fieldCount};
+
+        std::lock_guard<std::mutex> lock(dispatchMutex);
+        for (size_t i = 0; i < handlers->size(); ++i)
+        {
+            const RegisteredHandler &registered = (*handlers)[i];
+            LogHandlerState state = registered.monitor->state.load(std::memory_order_relaxed);
+            if (state == LogHandlerState::DISABLED)
+            {
+                continue;
+            }
+            entry.message = registered.raw ? message : clean;
+            if (sanitizeFailed && !registered.raw)
+            {
+                writeEmergency(registered, entry);
+                continue;
+            }
+            if (state == LogHandlerState::ISOLATED)
+            {
+                registered.monitor->enqueue(entry);
+                continue;
+            }
+            try
+            {
+                callHandler(registered, i, entry);
+            }
+            catch (const std::bad_alloc &)
+            {
+                writeEmergency(registered, entry);
+            }
+        }
+        if (endOfBatch)
+        {
+            callFlushHandlers();
+        }
+    }
+
+    // An entry the handler could not write for lack of memory: lay it out
+    // in the preallocated line and give it to the handler's fallback.
+    // Caller holds dispatchMutex.
+    void writeEmergency(const RegisteredHandler &registered, const LogEntry &entry)
+    {
+        LogStringRef line = formatEmergencyLine(entry, emergencyLine, sizeof(emergencyLine));
+        if (registered.emergency)
+        {
+            registered.emergency(entry, line);
+        }
+        else
+        {
+            writeDescriptor(STDERR_FILENO, line);
+        }
+    }
+
+    // Events are queued as raw bytes and rendered where they are dispatched
+    void writeEvent(LogLevel level, const LogSourceLocation &location, const LogEventSchema &schema, const void *data)
+    {
+        int64_t timestampNs = currentTimeNs();
+        if (asyncEnabled.load(std::memory_order_acquire))
+        {
+            try
+            {
+                if (enqueueEvent(level, timestampNs, location, schema, data))
+                {
+                    return;
+                }
+            }
+            catch (const std::bad_alloc &)
+            {
+                // Written from here instead, like writeLog()
+            }
+        }
+
+        if (!signalQueue.empty())
+        {
+            drainSignalRecords(true);
+        }
+        const ThreadIdentity &identity = currentThreadIdentity();
+        RenderedEvent rendered = renderEventForDispatch(schema, data);
+        dispatch(level, timestampNs, LogStringRef(location.file), LogStringRef(location.function, location.functionLength),
+                 location.line, rendered.message, identity.threadId, LogStringRef(identity.name, identity.nameLength),
+                 rendered.fields, rendered.fieldCount, true);
+    }
+
+    // ---- Signal-safe entries ----
+
+    // Runs in signal handlers: only atomics, memcpy and system calls that
+    // are async-signal-safe
+    void writeSignalSafe(LogLevel level, const LogSourceLocation &location, LogStringRef message) noexcept
+    {
+        SignalRecord *record = signalQueue.claim();
+        if (record == nullptr)
+        {
+            return;
+        }
+
+        int savedErrno = errno;
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        record->timestampNs = static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+        record->threadId = static_cast<uint64_t>(syscall(SYS_gettid));
+        errno = savedErrno;
+
+        // Decimal thread id, like an unnamed thread's name
+        char digits[24];
+        size_t count = 0;
+        uint64_t id = record->threadId;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + id % 10);
+            id /= 10;
+        } while (id != 0);
+        for (size_t i = 0; i < count; ++i)
+        {
+            record->threadName[i] = digits[count - 1 - i];
+        }
+        record->threadNameLength = static_cast<uint32_t>(count);
+
+        record->file = location.file;
+        record->function = location.function;
+        record->functionLength = static_cast<uint32_t>(location.functionLength);
+        record->lineNumber = location.line;
+        record->level = level;
+        size_t length = std::min(message.size(), sizeof(record->message) - 1);
+        std::memcpy(record->message, message.data(), length);
+        record->message[length] = '\0';
+        record->messageLength = static_cast<uint32_t>(length);
+        signalQueue.publish(record);
+    }
+
+    // Dispatch the queued signal-safe entries. Skipped if another thread is
+    // already draining them. Returns the number written.
+    size_t drainSignalRecords(bool endOfBatch)
+    {
+        std::unique_lock<std::mutex> lock(signalDrainMutex, std::try_to_lock);
+        if (!lock.owns_lock())
+        {
+            return 0;
+        }
+
+        size_t written = 0;
+        for (SignalRecord *record = signalQueue.front(); record != nullptr; record = signalQueue.front())
+        {
+            dispatch(record->level, record->timestampNs, LogStringRef(record->file),
+                     LogStringRef(record->function, record->functionLength), record->lineNumber,
+                     LogStringRef(record->message, record->messageLength), record->threadId,
+                     LogStringRef(record->threadName, record->threadNameLength), nullptr, 0, false);
+            signalQueue.pop();
+            ++written;
+        }
+        if (written > 0 && endOfBatch)
+        {
+            std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+            callFlushHandlers();
+        }
+        return written;
+    }
+
+    // ---- Asynchronous mode ----
+
+    RecordSlab *getThreadSlab()
+    {
+        if (!threadSlab.slab)
+        {
+            int node = (asyncOptions.numaLocal || asyncOptions.backendPerNode) && numaAvailable() ? currentNumaNode() : -1;
+            // Not make_shared: RecordSlab's own operator new aligns it
+            std::shared_ptr<RecordSlab> slab(new RecordSlab(asyncOptions.slabSize, asyncOptions.hugePages,
+                                                            asyncOptions.prefault || prefaultSlabs,
+                                                            activeMemoryResource(), node));
+            if (lockSlabs && !slab->lockMemory())
+            {
+                static std::once_flag lockWarning;
+                std::call_once(lockWarning, []
+                               { std::cerr << "Error locking log slab in memory (" << std::strerror(errno) << ")\n"; });
+            }
+            const ThreadIdentity &identity = currentThreadIdentity();
+            slab->setThreadName(identity.name, identity.nameLength);
+            {
+                std::lock_guard<std::mutex> lock(slabsMutex);
+                slabs.push_back(slab);
+            }
+            threadSlab.slab = slab;
+        }
+        return threadSlab.slab.get();
+    }
+
+    void enqueue(LogLevel level, int64_t timestampNs, const LogSourceLocation &location, bool copyFunction,
+                 LogStringRef message)
+    {
+        RecordSlab *slab = getThreadSlab();
+        if (message.size() > UINT32_MAX)
+        {
+            // Beyond what a record header describes: write it synchronously
+            dispatchFromThisThread(level, timestampNs, location, message);
+            return;
+        }
+        if (mustSpill(slab) && spill(slab, level, timestampNs, location, message, nullptr, 0))
+        {
+            return;
+        }
+
+        // Static call-site strings are referenced by pointer; only the
+        // message (plus the function name on the legacy path) is copied,
+        // right after the header. Records too large to share the slab
+        // comfortably keep their text in a heap block instead, freed by the
+        // backend after writing.
+        size_t functionSize = copyFunction ? location.functionLength + 1 : 0;
+        size_t textSize = functionSize + message.size() + 1;
+        size_t recordSize = RecordSlab::alignedSize(sizeof(RecordHeader) + textSize);
+        char *external = nullptr;
+        if (recordSize > slab->getCapacity() / 4)
+        {
+            external = static_cast<char *>(slab->getResource()->allocate(textSize, 1));
+            recordSize = RecordSlab::alignedSize(sizeof(RecordHeader));
+        }
+
+        char *block;
+        while ((block = slab->reserve(recordSize)) == nullptr)
+        {
+            if (spillEnabled.load(std::memory_order_relaxed) && spill(slab, level, timestampNs, location, message, nullptr, 0))
+            {
+                if (external != nullptr)
+                {
+                    slab->getResource()->deallocate(external, textSize, 1);
+                }
+                return;
+            }
+            if (!asyncEnabled.load(std::memory_order_acquire))
+            {
+                // Backend was stopped while we waited for space
+                if (external != nullptr)
+                {
+                    slab->getResource()->deallocate(external, textSize, 1);
+                }
+                dispatchFromThisThread(level, timestampNs, location, message);
+                return;
+            }
+            requestWake();
+            std::this_thread::yield();
+        }
+
+        RecordHeader *record = reinterpret_cast<RecordHeader *>(block);
+        record->size = static_cast<uint32_t>(recordSize);
+        record->kind = external ? RECORD_LOG_EXTERNAL : RECORD_LOG;
+        record->level = static_cast<uint16_t>(level);
+        record->lineNumber = location.line;
+        record->functionLength = static_cast<uint32_t>(location.functionLength);
+        record->messageLength = static_cast<uint32_t>(message.size());
+        record->threadId = static_cast<uint32_t>(currentThreadIdentity().threadId);
+        record->timestampNs = timestampNs;
+        record->file = location.file;
+        record->function = copyFunction ? nullptr : location.function;
+        record->external = external;
+        record->schema = nullptr;
+
+        char *text = external ? external : block + sizeof(RecordHeader);
+        std::memcpy(text, location.function, functionSize);
+        text += functionSize;
+        std::memcpy(text, message.data(), message.size());
+        text[message.size()] = '\0';
+
+        slab->publish();
+    }
+
+    // Copy an event into the slab; false if it has to be written synchronously
+    bool enqueueEvent(LogLevel level, int64_t timestampNs, const LogSourceLocation &location,
+                      const LogEventSchema &schema, const void *data)
+    {
+        RecordSlab *slab = getThreadSlab();
+        size_t recordSize = RecordSlab::alignedSize(sizeof(RecordHeader) + schema.size);
+        if (recordSize > slab->getCapacity() / 4)
+        {
+            return false;
+        }
+        if (mustSpill(slab) && spillEvent(slab, level, timestampNs, location, schema, data))
+        {
+            return true;
+        }
+
+        char *block;
+        while ((block = slab->reserve(recordSize)) == nullptr)
+        {
+            if (spillEnabled.load(std::memory_order_relaxed) && spillEvent(slab, level, timestampNs, location, schema, data))
+            {
+                return true;
+            }
+            if (!asyncEnabled.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            requestWake();
+            std::this_thread::yield();
+        }
+
+        RecordHeader *record = reinterpret_cast<RecordHeader *>(block);
+        record->size = static_cast<uint32_t>(recordSize);
+        record->kind = RECORD_EVENT;
+        record->level = static_cast<uint16_t>(level);
+        record->lineNumber = location.line;
+        record->functionLength = static_cast<uint32_t>(location.functionLength);
+        record->messageLength = static_cast<uint32_t>(schema.size);
+        record->threadId = static_cast<uint32_t>(currentThreadIdentity().threadId);
+        record->timestampNs = timestampNs;
+        record->file = location.file;
+        record->function = location.function;
+        record->external = nullptr;
+        record->schema = &schema;
+        std::memcpy(block + sizeof(RecordHeader), data, schema.size);
+
+        slab->publish();
+        return true;
+    }
+
+    // ---- Warm-up ----
+
+    void warmUp(const LogWarmupOptions &options)
+    {
+        prefaultSlabs = options.prefault;
+        lockSlabs = options.lockMemory;
+        if (options.loadTimezone)
+        {
+            // localtime_r() need not load the zone; tzset() does, once
+            tzset();
+        }
+        if (options.warmCallingThread)
+        {
+            warmThread();
+        }
+    }
+
+    // Pay the calling thread's first-use costs: its cached identity, the
+    // timestamp cache (localtime_r), the numeric formatting of its stream
+    // and, in asynchronous mode, its record slab
+    void warmThread()
+    {
+        const ThreadIdentity &identity = currentThreadIdentity();
+        timestampFormatter.format(currentTimeNs());
+        if (!threadStream.inUse)
+        {
+            // The common argument types, so their first use binds no symbols
+            threadStream.stream << "" << ' ' << 1 << identity.threadId << 0.5 << 0.5f;
+            threadStream.stream.reset();
+        }
+        if (asyncEnabled.load(std::memory_order_acquire))
+        {
+            getThreadSlab();
+        }
+    }
+
+    // ---- Real-time entries ----
+
+    void prepareRealtimeThread()
+    {
+        currentThreadIdentity();
+        getThreadSlab();
+    }
+
+    // Bounded: one reserve() attempt on the thread's own slab, a memcpy and
+    // a release store. Never spills (disk I/O) or wakes the backend (a
+    // futex call); the backend picks the entry up on its next poll.
+    void writeRealtime(LogLevel level, const LogSourceLocation &location, const char *payload, size_t size) noexcept
+    {
+        RecordSlab *slab = threadSlab.slab.get();
+        char *block = nullptr;
+        size_t recordSize = RecordSlab::alignedSize(sizeof(RecordHeader) + size);
+        // Records of this thread waiting in the spill file must not be
+        // overtaken, so the entry is dropped instead
+        if (slab != nullptr && asyncEnabled.load(std::memory_order_acquire) &&
+            slab->spilledRecords.load(std::memory_order_acquire) == 0)
+        {
+            block = slab->reserve(recordSize);
+        }
+        if (block == nullptr)
+        {
+            realtimeDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        RecordHeader *record = reinterpret_cast<RecordHeader *>(block);
+        record->size = static_cast<uint32_t>(recordSize);
+        record->kind = RECORD_REALTIME;
+        record->level = static_cast<uint16_t>(level);
+        record->lineNumber = location.line;
+        record->functionLength = static_cast<uint32_t>(location.functionLength);
+        record->messageLength = static_cast<uint32_t>(size);
+        record->threadId = static_cast<uint32_t>(threadIdentity.threadId);
+        record->timestampNs = currentTimeNs();
+        record->file = location.file;
+        record->function = location.function;
+        record->external = nullptr;
+        record->schema = nullptr;
+        std::memcpy(block + sizeof(RecordHeader), payload, size);
+
+        slab->publish();
+    }
+
+    // ---- Timing spans ----
+
+    void writeSpan(LogLevel level, const LogSourceLocation &location, const char *name, uint64_t beginTicks,
+                   uint64_t endTicks)
+    {
+        int64_t timestampNs = tickClock.toNs(beginTicks);
+        uint64_t durationNs = tickClock.durationNs(beginTicks, endTicks);
+        if (asyncEnabled.load(std::memory_order_acquire))
+        {
+            try
+            {
+                if (enqueueSpan(level, timestampNs, location, name, durationNs))
+                {
+                    return;
+                }
+            }
+            catch (const std::bad_alloc &)
+            {
+                // Written from here instead, like writeLog()
+            }
+        }
+
+        if (!signalQueue.empty())
+        {
+            drainSignalRecords(true);
+        }
+        const ThreadIdentity &identity = currentThreadIdentity();
+        RenderedEvent rendered = renderSpan(name, durationNs);
+        dispatch(level, timestampNs, LogStringRef(location.file), LogStringRef(location.function, location.functionLength),
+                 location.line, rendered.message, identity.threadId, LogStringRef(identity.name, identity.nameLength),
+                 rendered.fields, rendered.fieldCount, true);
+    }
+
+    // Queue a span as its name pointer and duration; false if it has to be
+    // written synchronously
+    bool enqueueSpan(LogLevel level, int64_t timestampNs, const LogSourceLocation &location, const char *name,
+                     uint64_t durationNs)
+    {
+        RecordSlab *slab = getThreadSlab();
+        if (mustSpill(slab))
+        {
+            RenderedEvent rendered = renderSpan(name, durationNs);
+            if (spill(slab, level, timestampNs, location, rendered.message, rendered.fields, rendered.fieldCount))
+            {
+                return true;
+            }
+        }
+
+        size_t recordSize = RecordSlab::alignedSize(sizeof(RecordHeader) + sizeof(SpanPayload));
+        char *block;
+        while ((block = slab->reserve(recordSize)) == nullptr)
+        {
+            if (spillEnabled.load(std::memory_order_relaxed))
+            {
+                RenderedEvent rendered = renderSpan(name, durationNs);
+                if (spill(slab, level, timestampNs, location, rendered.message, rendered.fields, rendered.fieldCount))
+                {
+                    return true;
+                }
+            }
+            if (!asyncEnabled.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            requestWake();
+            std::this_thread::yield();
+        }
+
+        RecordHeader *record = reinterpret_cast<RecordHeader *>(block);
+        record->size = static_cast<uint32_t>(recordSize);
+        record->kind = RECORD_SPAN;
+        record->level = static_cast<uint16_t>(level);
+        record->lineNumber = location.line;
+        record->functionLength = static_cast<uint32_t>(location.functionLength);
+        record->messageLength = static_cast<uint32_t>(sizeof(SpanPayload));
+        record->threadId = static_cast<uint32_t>(currentThreadIdentity().threadId);
+        record->timestampNs = timestampNs;
+        record->file = location.file;
+        record->function = location.function;
+        record->external = nullptr;
+        record->schema = nullptr;
+        SpanPayload payload{name, durationNs};
+        std::memcpy(block + sizeof(RecordHeader), &payload, sizeof(payload));
+
+        slab->publish();
+        return true;
+    }
+
+    // ---- Overflow to disk ----
+
+    // Once a thread has spilled, it keeps spilling until the backend has
+    // replayed those records, so none of its later records overtake them
+    bool mustSpill(RecordSlab *slab) const
+    {
+        return spillEnabled.load(std::memory_order_relaxed) &&
+               slab->spilledRecords.load(std::memory_order_acquire) > 0;
+    }
+
+    // Append a record to the spill file; false if it could not be written
+    bool spill(RecordSlab *slab, LogLevel level, int64_t timestampNs, const LogSourceLocation &location,
+               LogStringRef message, const LogField *fields, size_t fieldCount)
+    {
+        // Secrets never reach the disk; replaying masks the text again, which
+        // finds nothing left to mask
+        redact(message, fields, fieldCount);
+        const ThreadIdentity &identity = currentThreadIdentity();
+        SpilledRecord record{level, timestampNs, location.line, identity.threadId,
+                             static_cast<uint64_t>(reinterpret_cast<uintptr_t>(slab)), LogStringRef(location.file),
+                             LogStringRef(location.function, location.functionLength),
+                             LogStringRef(identity.name, identity.nameLength), message, fields, fieldCount, false};
+
+        // Counted first, so the backend never replays a record it has not seen counted
+        slab->spilledRecords.fetch_add(1, std::memory_order_acq_rel);
+        bool appended = false;
+        try
+        {
+            appended = spillFile.append(record);
+        }
+        catch (const std::bad_alloc &)
+        {
+            // No memory to encode the record: the caller queues it instead
+        }
+        if (!appended)
+        {
+            slab->spilledRecords.fetch_sub(1, std::memory_order_acq_rel);
+            return false;
+        }
+        requestWake();
+        return true;
+    }
+
+    // Spilled events are rendered here: the spill file outlives the process
+    bool spillEvent(RecordSlab *slab, LogLevel level, int64_t timestampNs, const LogSourceLocation &location,
+                    const LogEventSchema &schema, const void *data)
+    {
+        const EventRendering &rendering = renderEvent(schema, data);
+        return spill(slab, level, timestampNs, location, LogStringRef(rendering.message), rendering.fields.data(),
+                     rendering.fields.size());
+    }
+
+    void requestWake()
+    {
+        {
+            std::lock_guard<std::mutex> lock(backendMutex);
+            ++wakeGeneration;
+        }
+        backendWake.notify_all();
+    }
+
+    // Next log record of a slab, applying thread renames queued before it
+    static const RecordHeader *peekLogRecord(RecordSlab &slab, uint64_t limit)
+    {
+        const RecordHeader *record = slab.peek(limit);
+        while (record != nullptr && record->kind == RECORD_THREAD_NAME)
+        {
+            slab.setThreadName(record->text(), record->functionLength);
+            slab.advance();
+            record = slab.peek(limit);
+        }
+        return record;
+    }
+
+    // Queue a rename so records logged before it keep the old name
+    void enqueueThreadName(const ThreadIdentity &identity)
+    {
+        RecordSlab *slab = threadSlab.slab.get();
+        size_t recordSize = RecordSlab::alignedSize(sizeof(RecordHeader) + identity.nameLength + 1);
+        char *block;
+        while ((block = slab->reserve(recordSize)) == nullptr)
+        {
+            if (!asyncEnabled.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            requestWake();
+            std::this_thread::yield();
+        }
+
+        RecordHeader *record = reinterpret_cast<RecordHeader *>(block);
+        std::memset(record, 0, sizeof(RecordHeader));
+        record->size = static_cast<uint32_t>(recordSize);
+        record->kind = RECORD_THREAD_NAME;
+        record->functionLength = static_cast<uint32_t>(identity.nameLength);
+        std::memcpy(block + sizeof(RecordHeader), identity.name, identity.nameLength + 1);
+        slab->publish();
+    }
+
+    void setThreadName(const std::string &name)
+    {
+        nameCurrentThread(name);
+        if (threadSlab.slab)
+        {
+            enqueueThreadName(threadIdentity);
+        }
+    }
+
+    // True if `backend` drains `slab`: its own node's slabs, and for
+    // backends[0] also those of nodes without a backend
+    bool drainsSlab(const Backend &backend, const RecordSlab &slab) const
+    {
+        if (backends.size() == 1 || slab.getNode() == backend.node)
+        {
+            return true;
+        }
+        if (&backend != backends[0].get())
+        {
+            return false;
+        }
+        for (const auto &other : backends)
+        {
+            if (other->node == slab.getNode())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Write out everything published so far in the slabs of `backend` (or
+    // every slab), merging them in timestamp order. Returns the number of
+    // records written.
+    size_t drainSlabs(Backend &backend, bool everySlab)
+    {
+        std::vector<std::shared_ptr<RecordSlab>> &drainSnapshot = backend.drainSnapshot;
+        std::vector<uint64_t> &drainLimits = backend.drainLimits;
+        bool primary = &backend == backends[0].get();
+
+        // Entries from signal handlers are rare and go first
+        size_t written = primary ? drainSignalRecords(false) : 0;
+        {
+            std::lock_guard<std::mutex> lock(slabsMutex);
+            for (const auto &slab : slabs)
+            {
+                if (everySlab || drainsSlab(backend, *slab))
+                {
+                    drainSnapshot.push_back(slab);
+                }
+            }
+        }
+
+        drainLimits.resize(drainSnapshot.size());
+        double deepest = 0;
+        for (size_t i = 0; i < drainSnapshot.size(); ++i)
+        {
+            RecordSlab &slab = *drainSnapshot[i];
+            drainLimits[i] = slab.published();
+            // A thread spilling to disk found its slab full
+            double depth = slab.spilledRecords.load(std::memory_order_acquire) > 0
+                               ? 1.0
+                               : static_cast<double>(slab.backlog(drainLimits[i])) / slab.getCapacity();
+            deepest = std::max(deepest, depth);
+        }
+        backend.depth.store(deepest, std::memory_order_relaxed);
+        bool drainSpill = primary && spillEnabled;
+        uint64_t spillLimit = drainSpill ? spillFile.published() : 0;
+
+        while (true)
+        {
+            const RecordHeader *oldest = nullptr;
+            size_t oldestIndex = 0;
+            for (size_t i = 0; i < drainSnapshot.size(); ++i)
+            {
+                const RecordHeader *record = peekLogRecord(*drainSnapshot[i], drainLimits[i]);
+                if (record && (!oldest || record->timestampNs < oldest->timestampNs))
+                {
+                    oldest = record;
+                    oldestIndex = i;
+                }
+            }
+
+            // The spill file is one more source in the merge
+            const SpilledRecord *spilled = drainSpill ? spillFile.peek(spillLimit) : nullptr;
+            if (spilled && (!oldest || spilled->timestampNs <= oldest->timestampNs))
+            {
+                dispatch(spilled->level, spilled->timestampNs, spilled->file, spilled->function, spilled->lineNumber,
+                         spilled->message, spilled->threadId, spilled->threadName, spilled->fields,
+                         spilled->fieldCount, false);
+                if (!spilled->recovered)
+                {
+                    reinterpret_cast<RecordSlab *>(static_cast<uintptr_t>(spilled->source))
+                        ->spilledRecords.fetch_sub(1, std::memory_order_acq_rel);
+                }
+                spillFile.advance();
+                ++written;
+                continue;
+            }
+            if (!oldest)
+            {
+                break;
+            }
+
+            RecordSlab &slab = *drainSnapshot[oldestIndex];
+            if (oldest->kind == RECORD_SPAN)
+            {
+                SpanPayload payload;
+                std::memcpy(&payload, oldest->text(), sizeof(payload));
+                RenderedEvent rendered = renderSpan(payload.name, payload.durationNs);
+                dispatch(static_cast<LogLevel>(oldest->level), oldest->timestampNs, LogStringRef(oldest->file),
+                         LogStringRef(oldest->function, oldest->functionLength), oldest->lineNumber, rendered.message,
+                         oldest->threadId, LogStringRef(slab.threadName, slab.threadNameLength), rendered.fields,
+                         rendered.fieldCount, false);
+            }
+            else if (oldest->kind == RECORD_REALTIME)
+            {
+                LogStream::Lease stream;
+                renderRealtime(oldest->text(), oldest->messageLength, stream.get());
+                dispatch(static_cast<LogLevel>(oldest->level), oldest->timestampNs, LogStringRef(oldest->file),
+                         LogStringRef(oldest->function, oldest->functionLength), oldest->lineNumber,
+                         stream.get().text(), oldest->threadId,
+                         LogStringRef(slab.threadName, slab.threadNameLength), nullptr, 0, false);
+            }
+            else if (oldest->kind == RECORD_EVENT)
+            {
+                RenderedEvent rendered = renderEventForDispatch(*oldest->schema, oldest->text());
+                dispatch(static_cast<LogLevel>(oldest->level), oldest->timestampNs, LogStringRef(oldest->file),
+                         LogStringRef(oldest->function, oldest->functionLength), oldest->lineNumber, rendered.message,
+                         oldest->threadId, LogStringRef(slab.threadName, slab.threadNameLength), rendered.fields,
+                         rendered.fieldCount, false);
+            }
+            else
+            {
+                dispatch(static_cast<LogLevel>(oldest->level), oldest->timestampNs, LogStringRef(oldest->file),
+                         LogStringRef(oldest->functionText(), oldest->functionLength), oldest->lineNumber,
+                         LogStringRef(oldest->messageText(), oldest->messageLength),
+                         oldest->threadId, LogStringRef(slab.threadName, slab.threadNameLength), nullptr, 0, false);
+            }
+            drainSnapshot[oldestIndex]->releaseExternal(oldest);
+            drainSnapshot[oldestIndex]->advance();
+            ++written;
+        }
+
+        if (written > 0)
+        {
+            std::lock_guard<std::mutex> lock(dispatchMutex);
+            callFlushHandlers();
+        }
+        if (drainSpill)
+        {
+            spillFile.compact();
+        }
+
+        // Recycle consumed space in bulk, then drop slabs of exited threads
+        bool anyRetired = false;
+        for (const auto &slab : drainSnapshot)
+        {
+            slab->release();
+            anyRetired = anyRetired || slab->retired.load(std::memory_order_acquire);
+        }
+        if (anyRetired)
+        {
+            std::lock_guard<std::mutex> lock(slabsMutex);
+            slabs.erase(std::remove_if(slabs.begin(), slabs.end(),
+                                       [](const std::shared_ptr<RecordSlab> &slab)
+                                       { return slab->retired.load(std::memory_order_acquire) && slab->empty() &&
+                                                slab->spilledRecords.load(std::memory_order_acquire) == 0; }),
+                        slabs.end());
+        }
+        drainSnapshot.clear();
+        return written;
+    }
+
+    void backendLoop(Backend *backend)
+    {
+        const std::chrono::microseconds minIdleWait(100);
+        const std::chrono::microseconds maxIdleWait(10000);
+        std::chrono::microseconds idleWait = minIdleWait;
+
+        for (const NumaNode &node : numaNodes())
+        {
+            if (node.id == backend->node)
+            {
+                pinThreadToNumaNode(node);
+            }
+        }
+        bool primary = backend == backends[0].get();
+
+        std::unique_lock<std::mutex> lock(backendMutex);
+        while (true)
+        {
+            bool running = backendRunning;
+            backend->wakeSeen = wakeGeneration;
+            lock.unlock();
+            auto drainStart = std::chrono::steady_clock::now();
+            size_t written = drainSlabs(*backend, false);
+            if (primary)
+            {
+                updatePressure(std::chrono::steady_clock::now() - drainStart, written);
+            }
+            lock.lock();
+
+            ++backend->completedCycles;
+            backendCycleDone.notify_all();
+            if (!running)
+            {
+                break;
+            }
+
+            // Back off while idle; producers only wake us when a slab is full
+            if (written == 0)
+            {
+                backendWake.wait_for(lock, idleWait, [this, backend]
+                                     { return wakeGeneration != backend->wakeSeen || !backendRunning; });
+                idleWait = std::min(idleWait * 2, maxIdleWait);
+            }
+            else
+            {
+                idleWait = minIdleWait;
+            }
+        }
+    }
 
-    Impl(const std::string &name, LogLevel level)
-        : componentName(name), currentLevel(level)
+    // ---- Adaptive verbosity ----
+
+    // Fullest slab when the latest drains began, over all backends
+    double drainDepth() const
     {
-        // Register default console handler
+        double depth = 0;
+        for (const auto &backend : backends)
+        {
+            depth = std::max(depth, backend->depth.load(std::memory_order_relaxed));
+        }
+        return depth;
     }
 
-    static constexpr const char *levelToString(LogLevel level)
+    // Raise or restore the threshold after a drain (backend only)
+    void updatePressure(std::chrono::steady_clock::duration drainTime, size_t written)
     {
-        switch (level)
+        const AsyncLogOptions &options = asyncOptions;
+        if (options.pressureLevel == LogLevel::TRACE)
         {
-        case LogLevel::TRACE:
-            return "TRACE";
-        case LogLevel::DEBUG3:
-            return "DEBUG3";
-        case LogLevel::DEBUG2:
-            return "DEBUG2";
-        case LogLevel::DEBUG1:
-            return "DEBUG1";
-        case LogLevel::INFO:
-            return "INFO";
-        case LogLevel::WARN:
-            return "WARN";
-        case LogLevel::ERROR:
-            return "ERROR";
-        default:
-            return "UNKNOWN";
+            return;
         }
+
+        // Idle drains say nothing about write latency
+        if (options.pressureLatencyUs > 0 && written > 0)
+        {
+            slowWrites = drainTime / written >= std::chrono::microseconds(options.pressureLatencyUs);
+        }
+        double depth = drainDepth();
+        bool pressure = underPressure ? depth > options.pressureLowWatermark || slowWrites
+                                      : depth >= options.pressureHighWatermark || slowWrites;
+        if (pressure != underPressure)
+        {
+            setPressure(pressure, options.pressureLevel, drainTime / std::max<size_t>(written, 1));
+        }
+    }
+
+    void setPressure(bool pressure, LogLevel level, std::chrono::steady_clock::duration entryTime)
+    {
+        LogLevel effective;
+        {
+            std::lock_guard<std::mutex> lock(levelMutex);
+            underPressure = pressure;
+            pressureLevel = level;
+            effective = effectiveLevel();
+            enabledLevels.store(levelMask(effective), std::memory_order_relaxed);
+        }
+
+        // One notice line per change, whatever the threshold
+        LogStream::Lease stream;
+        std::ostream &notice = stream.get();
+        if (pressure)
+        {
+            notice << "Logging backend falling behind (slab " << static_cast<int>(drainDepth() * 100) << "% full, "
+                   << std::chrono::duration_cast<std::chrono::microseconds>(entryTime).count()
+                   << "us per entry): entries below " << logLevelInfo(effective).name << " suppressed";
+        }
+        else
+        {
+            notice << "Logging backend caught up: level restored to " << logLevelInfo(effective).name;
+        }
+        dispatchFromThisThread(pressure ? LogLevel::WARN : LogLevel::INFO, currentTimeNs(), LOG_CPP_SOURCE_LOCATION,
+                               stream.get().text());
     }
 
-    static std::string getCurrentTimestamp()
+    void startAsync(const AsyncLogOptions &options)
     {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        auto us_total = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()) % 1000000;
+        std::lock_guard<std::mutex> control(asyncControlMutex);
+        if (asyncEnabled.load())
+        {
+            return;
+        }
 
-        auto ms = us_total.count() / 1000;
-        auto us = us_total.count() % 1000;
+        asyncOptions = options;
+        slowWrites = false;
+        if (!options.spillPath.empty())
+        {
+            // Records left by a process that died are replayed first
+            spillEnabled.store(spillFile.open(options.spillPath), std::memory_order_relaxed);
+            if (!spillEnabled.load(std::memory_order_relaxed))
+            {
+                std::cerr << "Error opening log spill file: " << options.spillPath << "\n";
+            }
+        }
+        // Without a NUMA topology there is a single backend
+        if (options.backendPerNode && numaAvailable())
+        {
+            for (const NumaNode &node : numaNodes())
+            {
+                backends.emplace_back(new Backend(node.id));
+            }
+        }
+        else
+        {
+            backends.emplace_back(new Backend(-1));
+        }
+        {
+            std::lock_guard<std::mutex> lock(backendMutex);
+            backendRunning = true;
+        }
+        for (const auto &backend : backends)
+        {
+            backend->thread = std::thread(&Impl::backendLoop, this, backend.get());
+        }
 
-        std::ostringstream oss;
-        oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-        oss << '.' << ms << std::setfill('0') << std::setw(3) << us;
-        return oss.str();
+        // Create the caller's slab now so prefaulting happens at startup
+        getThreadSlab();
+        asyncEnabled.store(true, std::memory_order_release);
     }
 
-    void writeLog(LogLevel level, const std::string &function, int lineNumber, const std::string &message)
+    void stopAsync()
     {
-        if (level < currentLevel)
+        std::lock_guard<std::mutex> control(asyncControlMutex);
+        if (!asyncEnabled.load())
         {
-            return; // Don't log if below current level
+            return;
         }
 
-        LogEntry entry{
-            getCurrentTimestamp(),
-            levelToString(level),
-            componentName,
-            function,
-            lineNumber,
-            message};
+        asyncEnabled.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(backendMutex);
+            backendRunning = false;
+        }
+        backendWake.notify_all();
+        for (const auto &backend : backends)
+        {
+            backend->thread.join();
+        }
+
+        // Pick up records published while the backends were shutting down
+        drainSlabs(*backends[0], true);
+        if (underPressure)
+        {
+            setPressure(false, LogLevel::TRACE, std::chrono::steady_clock::duration::zero());
+        }
+        {
+            std::lock_guard<std::mutex> lock(backendMutex);
+            backends.clear();
+        }
+        stopIsolatedHandlers();
 
-        // Call all registered handlers (thread-safe)
+        if (spillEnabled)
         {
-            std::lock_guard<std::mutex> lock(handlersMutex);
-            for (const auto &handler : handlers)
+            // Records spilled during the last drain stay on disk for the
+            // next startAsync() or process
+            spillEnabled.store(false, std::memory_order_relaxed);
+            spillFile.close();
+            std::lock_guard<std::mutex> lock(slabsMutex);
+            for (const auto &slab : slabs)
             {
-                handler(entry);
+                slab->spilledRecords.store(0, std::memory_order_release);
             }
         }
     }
+
+    // Switch the calling thread's memory resource, dropping the stream
+    // storage and slab that came from the previous one
+    void setThreadMemoryResource(LogMemoryResource *resource)
+    {
+        threadMemoryResource = resource;
+        if (!threadStream.inUse)
+        {
+            threadStream.stream.releaseStorage();
+        }
+
+        if (threadSlab.slab && threadSlab.slab->getResource() != activeMemoryResource())
+        {
+            // The backend frees the retired slab once drained
+            threadSlab.slab->retired.store(true, std::memory_order_release);
+            threadSlab.slab.reset();
+            flush();
+        }
+    }
+
+    void flush()
+    {
+        if (!asyncEnabled.load(std::memory_order_acquire))
+        {
+            drainSignalRecords(true);
+            return;
+        }
+
+        // A cycle already in progress may have missed our records, so wait
+        // for the one after it to complete, on every backend
+        std::unique_lock<std::mutex> lock(backendMutex);
+        if (!backendRunning)
+        {
+            return;
+        }
+        std::vector<uint64_t> targets;
+        for (const auto &backend : backends)
+        {
+            targets.push_back(backend->completedCycles + 2);
+        }
+        ++wakeGeneration;
+        backendWake.notify_all();
+        backendCycleDone.wait(lock, [this, &targets]
+                              {
+            if (!backendRunning)
+            {
+                return true;
+            }
+            for (size_t i = 0; i < backends.size(); ++i)
+            {
+                if (backends[i]->completedCycles < targets[i])
+                {
+                    return false;
+                }
+            }
+            return true; });
+    }
 };
 
+// ========== LogStreamBuffer Implementation ==========
+
+LogStreamBuffer::LogStreamBuffer()
+    : storage(nullptr), storageSize(0), storageResource(nullptr), truncated(false)
+{
+    // Keep one byte free at the end for the NUL terminator
+    setp(inlineStorage, inlineStorage + sizeof(inlineStorage) - 1);
+}
+
+LogStreamBuffer::~LogStreamBuffer()
+{
+    releaseStorage();
+}
+
+LogStringRef LogStreamBuffer::text()
+{
+    if (truncated && pptr() - pbase() >= 3)
+    {
+        std::memcpy(pptr() - 3, "...", 3);
+    }
+    *pptr() = '\0';
+    return LogStringRef(pbase(), static_cast<size_t>(pptr() - pbase()));
+}
+
+void LogStreamBuffer::reset()
+{
+    // Give back storage grown by an unusually large message, or taken from
+    // a resource the thread no longer uses
+    if (storage != nullptr && (storageSize > 1024 * 1024 || storageResource != activeMemoryResource()))
+    {
+        releaseStorage();
+        return;
+    }
+    truncated = false;
+    setp(pbase(), epptr());
+}
+
+void LogStreamBuffer::releaseStorage()
+{
+    if (storage != nullptr)
+    {
+        storageResource->deallocate(storage, storageSize, 1);
+        storage = nullptr;
+        storageSize = 0;
+        storageResource = nullptr;
+    }
+    truncated = false;
+    setp(inlineStorage, inlineStorage + sizeof(inlineStorage) - 1);
+}
+
+LogStreamBuffer::int_type LogStreamBuffer::overflow(int_type ch)
+{
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        return traits_type::not_eof(ch);
+    }
+
+    if (!grow(1))
+    {
+        return traits_type::eof();
+    }
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+std::streamsize LogStreamBuffer::xsputn(const char *s, std::streamsize count)
+{
+    if (count <= 0)
+    {
+        return 0;
+    }
+
+    size_t length = static_cast<size_t>(count);
+    if (static_cast<size_t>(epptr() - pptr()) < length && !grow(length))
+    {
+        // Out of memory: keep what fits, so the message is cut, not lost
+        length = static_cast<size_t>(epptr() - pptr());
+    }
+
+    std::memcpy(pptr(), s, length);
+    advance(length);
+    return count;
+}
+
+void LogStreamBuffer::advance(size_t count)
+{
+    // pbump() takes an int, so advance large payloads in steps
+    while (count > static_cast<size_t>(INT_MAX))
+    {
+        pbump(INT_MAX);
+        count -= INT_MAX;
+    }
+    pbump(static_cast<int>(count));
+}
+
+bool LogStreamBuffer::grow(size_t required)
+{
+    if (truncated)
+    {
+        return false;
+    }
+    size_t used = static_cast<size_t>(pptr() - pbase());
+    size_t capacity = std::max(static_cast<size_t>(epptr() - pbase() + 1) * 2, used + required + 1);
+
+    LogMemoryResource *resource = activeMemoryResource();
+    char *grown;
+    try
+    {
+        grown = static_cast<char *>(resource->allocate(capacity, 1));
+    }
+    catch (const std::bad_alloc &)
+    {
+        truncated = true;
+        return false;
+    }
+    std::memcpy(grown, pbase(), used);
+    if (storage != nullptr)
+    {
+        storageResource->deallocate(storage, storageSize, 1);
+    }
+
+    storage = grown;
+    storageSize = capacity;
+    storageResource = resource;
+    setp(storage, storage + capacity - 1);
+    advance(used);
+    return true;
+}
+
+// ========== LogStream Implementation ==========
+
+void LogStream::reset()
+{
+    buffer.reset();
+    clear();
+    flags(std::ios_base::dec | std::ios_base::skipws);
+    precision(6);
+    fill(' ');
+    width(0);
+}
+
+LogStream::Lease::Lease()
+    : stream(nullptr)
+{
+    if (!threadStream.inUse)
+    {
+        threadStream.inUse = true;
+        threadStream.stream.reset();
+        stream = &threadStream.stream;
+    }
+    else
+    {
+        owned.reset(new LogStream);
+        stream = owned.get();
+    }
+}
+
+LogStream::Lease::~Lease()
+{
+    if (!owned)
+    {
+        threadStream.inUse = false;
+    }
+}
+
 // ========== Logger Static Members ==========
 
 Logger *Logger::instance = nullptr;
 
+// Read by defaultConsoleHandler, which is static and has no Impl to ask
+static std::atomic<bool> consoleColors(false);
+
 // ========== Logger Implementation ==========
 
 Logger::Logger(const std::string &name, LogLevel level)
     : impl(std::make_unique<Impl>(name, level))
 {
-    // Register default console handler
-    registerHandler(defaultConsoleHandler);
+    // Register default console handler; without memory it writes the
+    // preformatted line straight to stdout
+    registerHandler(defaultConsoleHandler, [](const LogEntry &, LogStringRef line)
+                    {
+                        std::cout.flush();
+                        writeDescriptor(STDOUT_FILENO, line); });
+
+    // Signal-safe entries queued just before the process exits (a SIGTERM
+    // handler, then return from main) are written by the exit hook, also
+    // in synchronous mode
+    Impl::installExitHook();
 }
 
 Logger::~Logger() = default;
@@ -114,60 +2551,253 @@ Logger *Logger::getInstance()
     return instance;
 }
 
-void Logger::initialize(const std::string &name, LogLevel level)
+void Logger::initialize(const std::string &name, LogLevel level, LogMemoryResource *resource)
+{
+    LogWarmupOptions none;
+    none.loadTimezone = false;
+    none.warmCallingThread = false;
+    none.prefault = false;
+    initialize(name, level, resource, none);
+}
+
+void Logger::initialize(const std::string &name, LogLevel level, LogMemoryResource *resource,
+                        const LogWarmupOptions &warmup)
 {
     static std::mutex initMutex;
     std::lock_guard<std::mutex> lock(initMutex);
-    if (instance == nullptr)
+    // A logger inherited across fork() is left as is (its locks may be
+    // held) and replaced
+    if (instance == nullptr || instance->impl->inherited)
     {
-        instance = new Logger(name, level);
+        Logger *logger = new Logger(name, level);
+        logger->setMemoryResource(resource);
+        logger->impl->warmUp(warmup);
+        instance = logger;
     }
 }
 
 void Logger::defaultConsoleHandler(const LogEntry &entry)
 {
-    std::ostringstream funcInfo;
-    funcInfo << entry.function << ":" << entry.lineNumber;
+    // Reused per thread so printing a line does not allocate
+    static thread_local std::string line;
 
-    std::ostringstream logStream;
-    logStream << "[" << entry.timestamp << "]"
-              << "[" << std::left << std::setw(6) << entry.level << "]"
-              << "[" << entry.component << "]"
-              << "[" << std::left << std::setw(20) << funcInfo.str() << "] "
-              << entry.message;
-    std::cout << logStream.str() << std::endl;
+    line.clear();
+    line += '[';
+    line.append(entry.timestamp.data(), entry.timestamp.size());
+    line += "][";
+    const LogLevelInfo &level = logLevelInfo(entry.severity);
+    if (consoleColors.load(std::memory_order_relaxed))
+    {
+        line.append(level.colored, level.coloredLength);
+    }
+    else
+    {
+        line.append(level.padded, LOG4CPP_LEVEL_WIDTH);
+    }
+    line += "][";
+    line.append(entry.component.data(), entry.component.size());
+    line += "][";
+    size_t funcInfoStart = line.size();
+    line.append(entry.function.data(), entry.function.size());
+    line += ':';
+    appendDecimal(line, entry.lineNumber);
+    size_t funcInfoWidth = line.size() - funcInfoStart;
+    if (funcInfoWidth < 20)
+    {
+        line.append(20 - funcInfoWidth, ' ');
+    }
+    line += "] ";
+    line.append(entry.message.data(), entry.message.size());
+    line += '\n';
+
+    std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+    std::cout.flush();
 }
 
 void Logger::registerHandler(OutputHandler handler)
 {
-    std::lock_guard<std::mutex> lock(impl->handlersMutex);
-    impl->handlers.push_back(handler);
+    impl->registerHandler(handler, false, EmergencyHandler());
+}
+
+void Logger::registerHandler(OutputHandler handler, EmergencyHandler emergency)
+{
+    impl->registerHandler(handler, false, emergency);
+}
+
+void Logger::registerRawHandler(OutputHandler handler, EmergencyHandler emergency)
+{
+    impl->registerHandler(handler, true, emergency);
 }
 
 void Logger::clearHandlers()
 {
-    std::lock_guard<std::mutex> lock(impl->handlersMutex);
-    impl->handlers.clear();
+    impl->clearHandlers();
 }
 
 void Logger::setHandler(OutputHandler handler)
 {
-    std::lock_guard<std::mutex> lock(impl->handlersMutex);
-    impl->handlers.clear();
-    impl->handlers.push_back(handler);
+    impl->setHandler(handler);
+}
+
+void Logger::registerFlushHandler(FlushHandler handler)
+{
+    impl->registerFlushHandler(std::move(handler));
+}
+
+void Logger::registerCloseHandler(FlushHandler handler)
+{
+    Impl::installExitHook();
+    impl->registerCloseHandler(std::move(handler));
+}
+
+void Logger::setSanitization(bool enabled)
+{
+    impl->sanitizeMessages.store(enabled, std::memory_order_relaxed);
+}
+
+void Logger::setRedactor(std::shared_ptr<const LogRedactor> redactor)
+{
+    impl->setRedactor(std::move(redactor));
 }
 
 void Logger::setLogLevel(LogLevel level)
 {
-    impl->currentLevel = level;
+    impl->setLogLevel(level);
+}
+
+void Logger::setHandlerWatchdog(uint32_t thresholdUs, bool isolate)
+{
+    impl->setHandlerWatchdog(thresholdUs, isolate);
+}
+
+std::vector<LogHandlerStats> Logger::getHandlerStats() const
+{
+    return impl->getHandlerStats();
 }
 
 LogLevel Logger::getLogLevel() const
 {
-    return impl->currentLevel;
+    return impl->currentLevel.load(std::memory_order_relaxed);
+}
+
+LogLevel Logger::getEffectiveLogLevel() const
+{
+    std::lock_guard<std::mutex> lock(impl->levelMutex);
+    return impl->effectiveLevel();
+}
+
+bool Logger::isEnabled(LogLevel level) const
+{
+    return impl->isEnabled(level);
+}
+
+void Logger::startAsync(const AsyncLogOptions &options)
+{
+    // Make sure records still queued at exit reach the handlers
+    Impl::installExitHook();
+    impl->startAsync(options);
+}
+
+void Logger::stopAsync()
+{
+    impl->stopAsync();
+}
+
+void Logger::flush()
+{
+    impl->flush();
+}
+
+void Logger::writeSignalSafe(LogLevel level, const LogSourceLocation &location, LogStringRef message) noexcept
+{
+    Logger *logger = instance;
+    if (logger != nullptr && logger->impl->isEnabled(level))
+    {
+        logger->impl->writeSignalSafe(level, location, message);
+    }
+}
+
+uint64_t Logger::getDroppedSignalSafeEntries() const
+{
+    return impl->signalQueue.dropped();
+}
+
+void Logger::warmThread()
+{
+    impl->warmThread();
+}
+
+void Logger::prepareRealtimeThread()
+{
+    impl->prepareRealtimeThread();
+}
+
+void Logger::writeRealtime(LogLevel level, const LogSourceLocation &location, const char *payload, size_t size) noexcept
+{
+    impl->writeRealtime(level, location, payload, size);
+}
+
+uint64_t Logger::getDroppedRealtimeEntries() const
+{
+    return impl->realtimeDropped.load(std::memory_order_relaxed);
+}
+
+void Logger::writeSpan(LogLevel level, const LogSourceLocation &location, const char *name, uint64_t beginTicks,
+                       uint64_t endTicks)
+{
+    impl->writeSpan(level, location, name, beginTicks, endTicks);
+}
+
+void Logger::setMemoryResource(LogMemoryResource *resource)
+{
+    loggerMemoryResource.store(resource, std::memory_order_release);
+}
+
+LogMemoryResource *Logger::getMemoryResource() const
+{
+    LogMemoryResource *resource = loggerMemoryResource.load(std::memory_order_acquire);
+    return resource != nullptr ? resource : defaultLogMemoryResource();
+}
+
+void Logger::setThreadName(const std::string &name)
+{
+    // Naming a thread before initialize() must not create the default logger
+    if (instance == nullptr)
+    {
+        nameCurrentThread(name);
+        return;
+    }
+    instance->impl->setThreadName(name);
+}
+
+void Logger::setConsoleColors(bool enabled)
+{
+    consoleColors.store(enabled, std::memory_order_relaxed);
+}
+
+void Logger::setThreadMemoryResource(LogMemoryResource *resource)
+{
+    // Before initialize() the thread has no slab or stream storage to drop,
+    // and the default logger must not be created
+    if (instance == nullptr)
+    {
+        threadMemoryResource = resource;
+        return;
+    }
+    instance->impl->setThreadMemoryResource(resource);
+}
+
+void Logger::writeLog(LogLevel level, const LogSourceLocation &location, LogStringRef message)
+{
+    impl->writeLog(level, location, false, message);
+}
+
+void Logger::writeEvent(LogLevel level, const LogSourceLocation &location, const LogEventSchema &schema, const void *data)
+{
+    impl->writeEvent(level, location, schema, data);
 }
 
-void Logger::writeLog(LogLevel level, const std::string &function, int lineNumber, const std::string &message)
+void Logger::writeLog(LogLevel level, const std::string &function, int lineNumber, LogStringRef message)
 {
-    impl->writeLog(level, function, lineNumber, message);
+    impl->writeLog(level, LogSourceLocation{"", function.c_str(), function.size(), lineNumber}, true, message);
 }
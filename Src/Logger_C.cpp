@@ -207,6 +207,41 @@ void logger_register_handler(CLogHandler handler)
         } });
 }
 
+// Name the calling thread
+void logger_set_thread_name(const char *name)
+{
+    Logger::setThreadName(name ? name : "");
+}
+
+// Switch to asynchronous logging
+void logger_start_async(void)
+{
+    Logger::getInstance()->startAsync();
+}
+
+// Return to synchronous logging
+void logger_stop_async(void)
+{
+    Logger::getInstance()->stopAsync();
+}
+
+// Wait for queued records to be written
+void logger_flush(void)
+{
+    Logger::getInstance()->flush();
+}
+
+// Queue an entry from a signal handler; strlen and the queue are signal-safe
+void logger_signal_safe(CLogLevel level, const char *function, int line, const char *message)
+{
+    if (!message)
+        return;
+
+    const char *name = function ? function : "";
+    Logger::writeSignalSafe(convertLogLevel(level), LogSourceLocation{"", name, strlen(name), line},
+                            LogStringRef(message, strlen(message)));
+}
+
 // Logging functions
 void logger_trace(CLogger logger, const char *format, ...)
 {
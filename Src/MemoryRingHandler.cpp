@@ -0,0 +1,219 @@
+#include "MemoryRingHandler.hpp"
+#include "CacheLine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+
+// ========== Record Layout ==========
+
+// Bytes kept for the file and function names together
+static const size_t SITE_CAPACITY = 128;
+
+struct RingRecordFields
+{
+    int64_t timestampNs;
+    uint64_t threadId;
+    int32_t lineNumber;
+    uint8_t level;
+    uint8_t truncated;
+    uint16_t fileLength;
+    uint16_t functionLength;
+    uint32_t messageLength;
+};
+
+// Each slot: this header, then file, function and message bytes
+struct RingSlotHeader
+{
+    // 2n + 1 while record n is being written, 2n + 2 once it is complete
+    std::atomic<uint64_t> sequence;
+    RingRecordFields fields;
+};
+
+// ========== MemoryRingHandler::Impl Definition ==========
+
+class MemoryRingHandler::Impl : public CacheLineAligned
+{
+public:
+    size_t capacity;
+    size_t maxMessageSize;
+    size_t textCapacity;
+    size_t slotSize; // Whole cache lines, so writers and readers of neighbouring slots do not share one
+    char *slots;
+
+    // Records written so far; only the handler call (one at a time) writes
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::atomic<uint64_t> head;
+
+    Impl(size_t records, size_t messageSize)
+        : capacity(std::max<size_t>(records, 1)), maxMessageSize(messageSize),
+          textCapacity(SITE_CAPACITY + messageSize), slots(nullptr), head(0)
+    {
+        slotSize = (sizeof(RingSlotHeader) + textCapacity + LOG4CPP_CACHE_LINE_SIZE - 1) &
+                   ~static_cast<size_t>(LOG4CPP_CACHE_LINE_SIZE - 1);
+        void *memory = nullptr;
+        if (posix_memalign(&memory, LOG4CPP_CACHE_LINE_SIZE, slotSize * capacity) != 0)
+        {
+            throw std::bad_alloc();
+        }
+        slots = static_cast<char *>(memory);
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            new (slots + i * slotSize) RingSlotHeader{{0}, RingRecordFields()};
+        }
+    }
+
+    ~Impl()
+    {
+        std::free(slots);
+    }
+
+    RingSlotHeader *slotFor(uint64_t record) const
+    {
+        return reinterpret_cast<RingSlotHeader *>(slots + (record % capacity) * slotSize);
+    }
+
+    static char *textOf(RingSlotHeader *slot)
+    {
+        return reinterpret_cast<char *>(slot + 1);
+    }
+
+    void write(const LogEntry &entry)
+    {
+        uint64_t record = head.load(std::memory_order_relaxed);
+        RingSlotHeader *slot = slotFor(record);
+        slot->sequence.store(2 * record + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        RingRecordFields &fields = slot->fields;
+        size_t fileLength = std::min(entry.file.size(), SITE_CAPACITY / 2);
+        size_t functionLength = std::min(entry.function.size(), SITE_CAPACITY - fileLength);
+        size_t messageLength = std::min(entry.message.size(), maxMessageSize);
+        fields.timestampNs = entry.timestampNs;
+        fields.threadId = entry.threadId;
+        fields.lineNumber = entry.lineNumber;
+        fields.level = static_cast<uint8_t>(entry.severity);
+        fields.truncated = messageLength < entry.message.size();
+        fields.fileLength = static_cast<uint16_t>(fileLength);
+        fields.functionLength = static_cast<uint16_t>(functionLength);
+        fields.messageLength = static_cast<uint32_t>(messageLength);
+
+        char *text = textOf(slot);
+        std::memcpy(text, entry.file.data(), fileLength);
+        std::memcpy(text + fileLength, entry.function.data(), functionLength);
+        std::memcpy(text + fileLength + functionLength, entry.message.data(), messageLength);
+
+        slot->sequence.store(2 * record + 2, std::memory_order_release);
+        head.store(record + 1, std::memory_order_release);
+    }
+
+    // Copy record `record` out of its slot; false if it was overwritten
+    // (or is being written) meanwhile
+    bool read(uint64_t record, RingRecordFields &fields, char *text) const
+    {
+        RingSlotHeader *slot = slotFor(record);
+        uint64_t expected = 2 * record + 2;
+        if (slot->sequence.load(std::memory_order_acquire) != expected)
+        {
+            return false;
+        }
+        std::memcpy(&fields, &slot->fields, sizeof(fields));
+        // Lengths of a torn copy may be garbage: stay inside the slot
+        size_t textSize = std::min(static_cast<size_t>(fields.fileLength) + fields.functionLength + fields.messageLength,
+                                   textCapacity);
+        std::memcpy(text, textOf(slot), textSize);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot->sequence.load(std::memory_order_relaxed) == expected;
+    }
+
+    static bool matches(const LogRingQuery &query, const RingRecordFields &fields, const char *text)
+    {
+        if (fields.level < static_cast<uint8_t>(query.minLevel) || fields.timestampNs < query.fromNs ||
+            fields.timestampNs > query.toNs)
+        {
+            return false;
+        }
+        const char *file = text;
+        const char *function = file + fields.fileLength;
+        const char *message = function + fields.functionLength;
+        if (!query.contains.empty() &&
+            std::search(message, message + fields.messageLength, query.contains.begin(), query.contains.end()) ==
+                message + fields.messageLength)
+        {
+            return false;
+        }
+        if (!query.site.empty() &&
+            std::search(file, file + fields.fileLength, query.site.begin(), query.site.end()) ==
+                file + fields.fileLength &&
+            std::search(function, function + fields.functionLength, query.site.begin(), query.site.end()) ==
+                function + fields.functionLength)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<LogRingRecord> query(const LogRingQuery &query) const
+    {
+        std::vector<LogRingRecord> results;
+        std::vector<char> text(textCapacity);
+        RingRecordFields fields;
+
+        // Newest first, so `limit` keeps the most recent matches. A record
+        // overwritten meanwhile means all older ones are gone as well.
+        uint64_t newest = head.load(std::memory_order_acquire);
+        uint64_t oldest = newest > capacity ? newest - capacity : 0;
+        for (uint64_t record = newest; record > oldest && results.size() < query.limit; --record)
+        {
+            if (!read(record - 1, fields, text.data()))
+            {
+                break;
+            }
+            if (!matches(query, fields, text.data()))
+            {
+                continue;
+            }
+            const char *file = text.data();
+            const char *function = file + fields.fileLength;
+            const char *message = function + fields.functionLength;
+            results.push_back(LogRingRecord{fields.timestampNs, static_cast<LogLevel>(fields.level), fields.threadId,
+                                            std::string(file, fields.fileLength),
+                                            std::string(function, fields.functionLength), fields.lineNumber,
+                                            std::string(message, fields.messageLength), fields.truncated != 0});
+        }
+        std::reverse(results.begin(), results.end());
+        return results;
+    }
+};
+
+// ========== MemoryRingHandler Implementation ==========
+
+MemoryRingHandler::MemoryRingHandler(size_t capacity, size_t maxMessageSize)
+    : impl(new Impl(capacity, maxMessageSize))
+{
+}
+
+MemoryRingHandler::~MemoryRingHandler() = default;
+
+std::vector<LogRingRecord> MemoryRingHandler::query(const LogRingQuery &query) const
+{
+    return impl->query(query);
+}
+
+uint64_t MemoryRingHandler::getTotalEntries() const
+{
+    return impl->head.load(std::memory_order_acquire);
+}
+
+void MemoryRingHandler::write(const LogEntry &entry)
+{
+    impl->write(entry);
+}
+
+MemoryRingHandler *registerMemoryRingHandler(size_t capacity, size_t maxMessageSize)
+{
+    MemoryRingHandler *handler = new MemoryRingHandler(capacity, maxMessageSize);
+    Logger::getInstance()->registerHandler(std::bind(&MemoryRingHandler::write, handler, std::placeholders::_1));
+    return handler;
+}
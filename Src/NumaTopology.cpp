@@ -0,0 +1,125 @@
+#include "NumaTopology.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <pthread.h>
+#include <sched.h>
+#include <string>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// ========== Helpers ==========
+
+// Memory policy mode of mbind(2), from <numaif.h>
+static const int NUMA_MPOL_PREFERRED = 1;
+
+static bool readLine(const std::string &path, std::string &line)
+{
+    FILE *file = std::fopen(path.c_str(), "r");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    char buffer[4096];
+    bool ok = std::fgets(buffer, sizeof(buffer), file) != nullptr;
+    std::fclose(file);
+    if (ok)
+    {
+        line = buffer;
+    }
+    return ok;
+}
+
+// Parse a sysfs list such as "0-3,8-11"
+static std::vector<int> parseList(const std::string &text)
+{
+    std::vector<int> values;
+    const char *cursor = text.c_str();
+    while (*cursor >= '0' && *cursor <= '9')
+    {
+        char *end = nullptr;
+        long first = std::strtol(cursor, &end, 10);
+        long last = first;
+        if (*end == '-')
+        {
+            last = std::strtol(end + 1, &end, 10);
+        }
+        for (long value = first; value <= last; ++value)
+        {
+            values.push_back(static_cast<int>(value));
+        }
+        cursor = *end == ',' ? end + 1 : end;
+    }
+    return values;
+}
+
+static std::vector<NumaNode> readTopology()
+{
+    std::vector<NumaNode> nodes;
+    std::string online;
+    if (!readLine("/sys/devices/system/node/online", online))
+    {
+        return nodes;
+    }
+    for (int id : parseList(online))
+    {
+        std::string cpus;
+        if (readLine("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist", cpus))
+        {
+            NumaNode node{id, parseList(cpus)};
+            if (!node.cpus.empty())
+            {
+                nodes.push_back(node);
+            }
+        }
+    }
+    return nodes;
+}
+
+// ========== NUMA Topology ==========
+
+const std::vector<NumaNode> &numaNodes()
+{
+    static const std::vector<NumaNode> nodes = readTopology();
+    return nodes;
+}
+
+bool numaAvailable()
+{
+    return numaNodes().size() > 1;
+}
+
+int currentNumaNode()
+{
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+    {
+        return -1;
+    }
+    return static_cast<int>(node);
+}
+
+bool preferNumaNode(void *memory, size_t size, int node)
+{
+    if (node < 0 || node >= 63)
+    {
+        return false;
+    }
+    unsigned long mask = 1ul << node;
+    // The kernel reads one bit less than maxnode
+    return syscall(SYS_mbind, memory, size, NUMA_MPOL_PREFERRED, &mask, sizeof(mask) * 8 + 1, 0) == 0;
+}
+
+bool pinThreadToNumaNode(const NumaNode &node)
+{
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (int cpu : node.cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &cpus);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+}
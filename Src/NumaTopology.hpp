@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// One NUMA node that has CPUs
+struct NumaNode
+{
+    int id;
+    std::vector<int> cpus;
+};
+
+/**
+ * NUMA topology, read from /sys/devices/system/node without libnuma
+ *
+ * Memory policy and CPU affinity go through the system calls directly, so
+ * the library has no extra dependency. Machines with a single node, or
+ * without the sysfs tree (non-NUMA kernels, containers that hide it),
+ * report one node or none, and callers then use plain memory and a single
+ * backend.
+ */
+
+// Nodes with CPUs, read once; empty if the topology is unknown
+const std::vector<NumaNode> &numaNodes();
+
+// True if there is more than one node worth placing memory on
+bool numaAvailable();
+
+// Node of the CPU the calling thread is running on; -1 if unknown
+int currentNumaNode();
+
+// Prefer `node` for the pages of a mapping that have not been touched yet
+bool preferNumaNode(void *memory, size_t size, int node);
+
+// Keep the calling thread on the CPUs of `node`
+bool pinThreadToNumaNode(const NumaNode &node);
@@ -0,0 +1,172 @@
+#include "RecordSlab.hpp"
+#include "NumaTopology.hpp"
+#include <new>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// ========== Helpers ==========
+
+static size_t roundUpPowerOfTwo(size_t value)
+{
+    size_t result = 4096;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// ========== RecordSlab Implementation ==========
+
+RecordSlab::RecordSlab(size_t requestedCapacity, bool hugePages, bool prefault, LogMemoryResource *memoryResource,
+                       int numaNode)
+    : retired(false), spilledRecords(0), threadNameLength(0), resource(memoryResource), node(-1), mapped(memoryResource == defaultLogMemoryResource()), locked(false), base(nullptr),
+      capacity(roundUpPowerOfTwo(requestedCapacity)), mappedSize(0), mask(0),
+      writePos(0), writeCursor(0), cachedReadPos(0), readPos(0), readCursor(0)
+{
+    mask = capacity - 1;
+    mappedSize = capacity;
+    threadName[0] = '\0';
+
+    if (!mapped)
+    {
+        base = static_cast<char *>(resource->allocate(capacity, 64));
+        if (prefault)
+        {
+            std::memset(base, 0, capacity);
+        }
+        return;
+    }
+
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    // With a NUMA node the pages are touched below, once the policy is set
+    if (prefault && numaNode < 0)
+    {
+        flags |= MAP_POPULATE;
+    }
+
+    void *memory = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (hugePages && capacity >= HUGE_PAGE_SIZE)
+    {
+        // Explicit huge pages need a reserved pool; fall back silently below
+        memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+    }
+#endif
+    if (memory == MAP_FAILED)
+    {
+        memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (memory == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+#ifdef MADV_HUGEPAGE
+        if (hugePages)
+        {
+            // Transparent huge pages, if the kernel allows them
+            madvise(memory, mappedSize, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    base = static_cast<char *>(memory);
+    if (numaNode >= 0 && preferNumaNode(memory, mappedSize, numaNode))
+    {
+        node = numaNode;
+    }
+
+    if (prefault)
+    {
+        // MAP_POPULATE is only a hint; touch every page to be sure
+        long pageSize = sysconf(_SC_PAGESIZE);
+        for (size_t offset = 0; offset < mappedSize; offset += static_cast<size_t>(pageSize))
+        {
+            base[offset] = 0;
+        }
+    }
+}
+
+RecordSlab::~RecordSlab()
+{
+    // Free any oversized records that were never consumed
+    uint64_t limit = writePos.load(std::memory_order_acquire);
+    while (const RecordHeader *record = peek(limit))
+    {
+        releaseExternal(record);
+        advance();
+    }
+
+    if (locked)
+    {
+        munlock(base, mappedSize);
+    }
+    if (mapped)
+    {
+        munmap(base, mappedSize);
+    }
+    else
+    {
+        resource->deallocate(base, capacity, 64);
+    }
+}
+
+bool RecordSlab::lockMemory()
+{
+    if (!locked)
+    {
+        locked = mlock(base, mappedSize) == 0;
+    }
+    return locked;
+}
+
+char *RecordSlab::reserve(size_t size)
+{
+    uint64_t pos = writeCursor;
+    size_t offset = static_cast<size_t>(pos & mask);
+    size_t tail = capacity - offset;
+    size_t needed = size <= tail ? size : size + tail;
+
+    if (needed > capacity)
+    {
+        return nullptr;
+    }
+
+    if (capacity - (pos - cachedReadPos) < needed)
+    {
+        cachedReadPos = readPos.load(std::memory_order_acquire);
+        if (capacity - (pos - cachedReadPos) < needed)
+        {
+            return nullptr;
+        }
+    }
+
+    if (size > tail)
+    {
+        // Not enough room before the end of the ring: pad and wrap around
+        RecordHeader *padding = recordAt(pos);
+        padding->size = static_cast<uint32_t>(tail);
+        padding->kind = RECORD_PADDING;
+        pos += tail;
+        offset = 0;
+    }
+
+    writeCursor = pos + size;
+    return base + offset;
+}
+
+const RecordHeader *RecordSlab::peek(uint64_t limit)
+{
+    while (readCursor < limit)
+    {
+        const RecordHeader *record = recordAt(readCursor);
+        if (record->kind != RECORD_PADDING)
+        {
+            return record;
+        }
+        readCursor += record->size;
+    }
+    return nullptr;
+}
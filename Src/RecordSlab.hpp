@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "CacheLine.hpp"
+#include "LogMemoryResource.hpp"
+#include "Logger.hpp"
+#include "LogEvent.hpp"
+
+// Record types stored in a RecordSlab
+enum RecordKind : uint16_t
+{
+    RECORD_PADDING,      // Filler up to the end of the ring, skipped by the consumer
+    RECORD_LOG,          // Function name and message stored inline after the header
+    RECORD_LOG_EXTERNAL, // Oversized record, text lives in a heap block owned by the record
+    RECORD_THREAD_NAME,  // New name of the producing thread, stored like a function name
+    RECORD_EVENT,        // Raw bytes of a LOG4CPP_EVENT struct (messageLength bytes), described by schema
+    RECORD_REALTIME,     // Tagged LOG_CPP_REALTIME arguments (messageLength bytes), formatted by the consumer
+    RECORD_SPAN          // SpanPayload of a LOG_CPP_SPAN; timestampNs is the start of the span
+};
+
+// Fixed header at the start of every record. The first 8 bytes (size, kind)
+// are all a padding record uses, so padding can fill any 8-byte aligned gap.
+struct RecordHeader
+{
+    uint32_t size; // Total record size in bytes, including alignment padding
+    uint16_t kind;
+    uint16_t level;
+    int32_t lineNumber;
+    uint32_t functionLength;
+    uint32_t messageLength;
+    uint32_t threadId;
+    int64_t timestampNs;
+    const char *file;     // Static source file name, or nullptr
+    const char *function; // Static function name, or nullptr if it is stored in the text
+    char *external;       // Record text for RECORD_LOG_EXTERNAL, else nullptr
+    const LogEventSchema *schema; // RECORD_EVENT only
+
+    // Text follows the header (or sits in external) as "function\0message\0",
+    // or just "message\0" when the function name is a static string
+    const char *text() const
+    {
+        return external ? external : reinterpret_cast<const char *>(this + 1);
+    }
+
+    const char *functionText() const { return function ? function : text(); }
+
+    const char *messageText() const { return function ? text() : text() + functionLength + 1; }
+
+    size_t textSize() const { return (function ? 0 : functionLength + 1) + messageLength + 1; }
+};
+
+// Body of a RECORD_SPAN record
+struct SpanPayload
+{
+    const char *name; // Static span name
+    uint64_t durationNs;
+};
+
+/**
+ * RecordSlab - Per-thread ring of variable-length inline log records
+ *
+ * Single producer (the owning thread), single consumer (the backend thread).
+ * A record is one contiguous block (header + function name + message), so
+ * queuing a message never touches the heap. The consumer recycles space in
+ * bulk by publishing its read position once per drain.
+ *
+ * With the default memory resource the ring is mapped with mmap(),
+ * optionally backed by huge pages; any other LogMemoryResource supplies the
+ * ring and oversized record text itself. Either way the ring can be
+ * prefaulted so the first messages do not take page faults. A mapped ring
+ * can also be placed on a given NUMA node.
+ */
+class RecordSlab : public CacheLineAligned
+{
+public:
+    // node: NUMA node to place a mapped ring on, -1 for the default policy
+    RecordSlab(size_t capacity, bool hugePages, bool prefault, LogMemoryResource *resource, int node = -1);
+    ~RecordSlab();
+
+    RecordSlab(const RecordSlab &) = delete;
+    RecordSlab &operator=(const RecordSlab &) = delete;
+
+    // Records are padded to this alignment
+    static const size_t RECORD_ALIGNMENT = 8;
+
+    static size_t alignedSize(size_t size)
+    {
+        return (size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+    }
+
+    size_t getCapacity() const { return capacity; }
+
+    // NUMA node the ring was placed on, -1 if none
+    int getNode() const { return node; }
+
+    // Resource the slab and its oversized records are allocated from
+    LogMemoryResource *getResource() const { return resource; }
+
+    // Keep the ring in RAM (mlock); false if the limit for locked memory
+    // (RLIMIT_MEMLOCK) does not allow it
+    bool lockMemory();
+
+    // ---- Producer side ----
+
+    // Reserve an aligned block of `size` bytes; nullptr if the ring is full
+    char *reserve(size_t size);
+
+    // Make all reserved records visible to the consumer
+    void publish() { writePos.store(writeCursor, std::memory_order_release); }
+
+    // ---- Consumer side ----
+
+    // Position up to which records have been published
+    uint64_t published() const { return writePos.load(std::memory_order_acquire); }
+
+    // Next record before `limit`, skipping padding; nullptr if none
+    const RecordHeader *peek(uint64_t limit);
+
+    // Step past the record returned by peek()
+    void advance() { readCursor += recordAt(readCursor)->size; }
+
+    // Bytes published up to `limit` and not consumed yet
+    size_t backlog(uint64_t limit) const { return static_cast<size_t>(limit - readCursor); }
+
+    // Free the heap text of a RECORD_LOG_EXTERNAL record
+    void releaseExternal(const RecordHeader *record)
+    {
+        if (record->external != nullptr)
+        {
+            resource->deallocate(record->external, record->textSize(), 1);
+        }
+    }
+
+    // Hand all consumed space back to the producer in one store
+    void release() { readPos.store(readCursor, std::memory_order_release); }
+
+    // True once the consumer has caught up with everything published
+    bool empty() const { return readPos.load(std::memory_order_acquire) == writePos.load(std::memory_order_acquire); }
+
+    // Set by the owning thread on exit; the consumer frees the slab once drained
+    std::atomic<bool> retired;
+
+    // Records of this thread waiting in the spill file. While nonzero the
+    // thread spills every record, so none overtakes an older spilled one.
+    std::atomic<uint32_t> spilledRecords;
+
+    // Name of the producing thread as of the record being consumed. Set at
+    // creation, then only by the consumer from RECORD_THREAD_NAME records.
+    void setThreadName(const char *name, size_t length)
+    {
+        threadNameLength = length < sizeof(threadName) - 1 ? length : sizeof(threadName) - 1;
+        std::memcpy(threadName, name, threadNameLength);
+        threadName[threadNameLength] = '\0';
+    }
+
+    char threadName[LOG4CPP_THREAD_NAME_CAPACITY];
+    size_t threadNameLength;
+
+private:
+    LogMemoryResource *resource;
+    int node;
+    bool mapped;
+    bool locked;
+    char *base;
+    size_t capacity;
+    size_t mappedSize;
+    size_t mask;
+
+    // Producer-owned cache line
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::atomic<uint64_t> writePos;
+    uint64_t writeCursor;
+    uint64_t cachedReadPos;
+
+    // Consumer-owned cache line
+    alignas(LOG4CPP_CACHE_LINE_SIZE) std::atomic<uint64_t> readPos;
+    uint64_t readCursor;
+
+    RecordHeader *recordAt(uint64_t pos) const
+    {
+        return reinterpret_cast<RecordHeader *>(base + (pos & mask));
+    }
+};
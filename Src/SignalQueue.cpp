@@ -0,0 +1,77 @@
+#include "SignalQueue.hpp"
+
+// ========== SignalQueue Implementation ==========
+
+SignalQueue::SignalQueue(size_t capacity)
+    : enqueuePosition(0), dequeuePosition(0), droppedRecords(0)
+{
+    size_t size = 2;
+    while (size < capacity)
+    {
+        size *= 2;
+    }
+    slots.reset(new Slot[size]);
+    mask = size - 1;
+    for (size_t i = 0; i < size; ++i)
+    {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+SignalRecord *SignalQueue::claim() noexcept
+{
+    size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Slot &slot = slots[position & mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0)
+        {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                return &slot.record;
+            }
+        }
+        else if (difference < 0)
+        {
+            droppedRecords.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        else
+        {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void SignalQueue::publish(SignalRecord *record) noexcept
+{
+    // The slot's position follows from its address and the current sequence
+    Slot *slot = reinterpret_cast<Slot *>(reinterpret_cast<char *>(record) - offsetof(Slot, record));
+    size_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_release);
+}
+
+SignalRecord *SignalQueue::front() noexcept
+{
+    size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    Slot &slot = slots[position & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+    {
+        return nullptr;
+    }
+    return &slot.record;
+}
+
+void SignalQueue::pop() noexcept
+{
+    size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    slots[position & mask].sequence.store(position + mask + 1, std::memory_order_release);
+    dequeuePosition.store(position + 1, std::memory_order_relaxed);
+}
+
+bool SignalQueue::empty() const noexcept
+{
+    return enqueuePosition.load(std::memory_order_acquire) == dequeuePosition.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "LogSignalSafe.hpp"
+
+// One entry logged from a signal handler, formatted in place
+struct SignalRecord
+{
+    int64_t timestampNs;
+    uint64_t threadId;
+    const char *file;     // Static call-site strings
+    const char *function;
+    uint32_t functionLength;
+    int lineNumber;
+    LogLevel level;
+    uint32_t messageLength;
+    uint32_t threadNameLength;
+    char threadName[24]; // Decimal thread id
+    char message[LOG4CPP_SIGNAL_MESSAGE_CAPACITY];
+};
+
+/**
+ * SignalQueue - Bounded lock-free queue of records logged from signal handlers
+ *
+ * Many producers, one consumer. Every slot is allocated up front and a
+ * producer only claims a slot with a compare-and-swap, fills it and
+ * publishes it with a store, so push() may run in a signal handler, even
+ * one that interrupted a push() on the same thread. A full queue drops the
+ * record and counts it.
+ *
+ * Slots carry a sequence number (Vyukov's bounded queue): a slot is free for
+ * position p when its sequence is p, and holds a record when it is p + 1.
+ */
+class SignalQueue
+{
+public:
+    explicit SignalQueue(size_t capacity);
+
+    SignalQueue(const SignalQueue &) = delete;
+    SignalQueue &operator=(const SignalQueue &) = delete;
+
+    // ---- Producer side (async-signal-safe) ----
+
+    // Claim a slot to fill; nullptr (and one more drop counted) if full
+    SignalRecord *claim() noexcept;
+
+    // Make a claimed slot visible to the consumer
+    void publish(SignalRecord *record) noexcept;
+
+    // ---- Consumer side (one thread at a time) ----
+
+    // Oldest published record, or nullptr
+    SignalRecord *front() noexcept;
+
+    // Release the record returned by front()
+    void pop() noexcept;
+
+    // True if nothing has been claimed since the last pop() (any thread)
+    bool empty() const noexcept;
+
+    // Records dropped because the queue was full
+    uint64_t dropped() const noexcept { return droppedRecords.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        SignalRecord record;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    std::atomic<size_t> enqueuePosition;
+    std::atomic<size_t> dequeuePosition; // Written by the consumer only
+    std::atomic<uint64_t> droppedRecords;
+};
@@ -0,0 +1,362 @@
+#include "SpillFile.hpp"
+#include "LogFraming.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ========== Record Encoding ==========
+
+// Records use native byte order: a spill file is only read back on the
+// machine that wrote it. Layout of the body:
+//   timestamp (8), thread id (8), source (8), line (4), level (1),
+//   file, function, thread name, message (each: length (4), bytes, NUL),
+//   field count (4), then per field: key, type (1), value (string or 8 bytes)
+
+static const size_t RECORD_HEADER_SIZE = 8; // Body length + CRC32C
+static const size_t READ_CHUNK = 64 * 1024;
+
+template <typename T>
+static void appendValue(std::string &out, T value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static void appendText(std::string &out, LogStringRef text)
+{
+    appendValue(out, static_cast<uint32_t>(text.size()));
+    out.append(text.data(), text.size());
+    out += '\0';
+}
+
+// Bounds-checked reader over a record body
+class BodyReader
+{
+public:
+    BodyReader(const char *data, size_t size) : position(data), end(data + size), valid(true) {}
+
+    template <typename T>
+    T value()
+    {
+        T result = T();
+        if (!take(sizeof(T)))
+        {
+            return result;
+        }
+        std::memcpy(&result, position - sizeof(T), sizeof(T));
+        return result;
+    }
+
+    LogStringRef text()
+    {
+        uint32_t length = value<uint32_t>();
+        const char *start = position;
+        if (!take(static_cast<size_t>(length) + 1) || start[length] != '\0')
+        {
+            valid = false;
+            return LogStringRef();
+        }
+        return LogStringRef(start, length);
+    }
+
+    bool ok() const { return valid; }
+    bool atEnd() const { return position == end; }
+
+private:
+    const char *position;
+    const char *end;
+    bool valid;
+
+    bool take(size_t size)
+    {
+        if (!valid || static_cast<size_t>(end - position) < size)
+        {
+            valid = false;
+            return false;
+        }
+        position += size;
+        return true;
+    }
+};
+
+static bool writeAll(int fd, const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// ========== SpillFile Implementation ==========
+
+SpillFile::SpillFile()
+    : fd(-1), writeEnd(0), readCursor(0), recoveredEnd(0), readBufferOffset(0), headValid(false), headSize(0), head()
+{
+}
+
+SpillFile::~SpillFile()
+{
+    close();
+}
+
+bool SpillFile::open(const std::string &spillPath)
+{
+    close();
+    path = spillPath;
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    // Keep what an earlier process left, minus a record torn by its death
+    readCursor = 0;
+    readBuffer.clear();
+    readBufferOffset = 0;
+    headValid = false;
+    size_t size = validPrefix();
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        size = 0;
+    }
+    readBuffer.clear();
+    readBufferOffset = 0;
+    recoveredEnd = size;
+    writeEnd.store(size, std::memory_order_release);
+    return true;
+}
+
+void SpillFile::close()
+{
+    std::lock_guard<std::mutex> lock(appendMutex);
+    if (fd < 0)
+    {
+        return;
+    }
+    if (readCursor == writeEnd.load(std::memory_order_acquire))
+    {
+        ::unlink(path.c_str());
+    }
+    ::close(fd);
+    fd = -1;
+    headValid = false;
+}
+
+size_t SpillFile::validPrefix()
+{
+    struct stat statbuf;
+    if (fstat(fd, &statbuf) != 0)
+    {
+        return 0;
+    }
+    uint64_t size = static_cast<uint64_t>(statbuf.st_size);
+
+    uint64_t offset = 0;
+    while (load(offset, RECORD_HEADER_SIZE, size))
+    {
+        uint32_t bodySize;
+        uint32_t crc;
+        const char *header = readBuffer.data() + (offset - readBufferOffset);
+        std::memcpy(&bodySize, header, sizeof(bodySize));
+        std::memcpy(&crc, header + 4, sizeof(crc));
+        if (!load(offset, RECORD_HEADER_SIZE + bodySize, size))
+        {
+            break;
+        }
+        const char *body = readBuffer.data() + (offset - readBufferOffset) + RECORD_HEADER_SIZE;
+        if (logCrc32c(body, bodySize) != crc)
+        {
+            break;
+        }
+        offset += RECORD_HEADER_SIZE + bodySize;
+    }
+    return static_cast<size_t>(offset);
+}
+
+bool SpillFile::append(const SpilledRecord &record)
+{
+    static thread_local std::string encoded;
+    encoded.assign(RECORD_HEADER_SIZE, '\0');
+    appendValue(encoded, record.timestampNs);
+    appendValue(encoded, record.threadId);
+    appendValue(encoded, record.source);
+    appendValue(encoded, static_cast<int32_t>(record.lineNumber));
+    appendValue(encoded, static_cast<uint8_t>(record.level));
+    appendText(encoded, record.file);
+    appendText(encoded, record.function);
+    appendText(encoded, record.threadName);
+    appendText(encoded, record.message);
+    appendValue(encoded, static_cast<uint32_t>(record.fieldCount));
+    for (size_t i = 0; i < record.fieldCount; ++i)
+    {
+        const LogField &field = record.fields[i];
+        appendText(encoded, field.key);
+        appendValue(encoded, static_cast<uint8_t>(field.type));
+        if (field.type == LogFieldType::STRING)
+        {
+            appendText(encoded, field.stringValue);
+        }
+        else
+        {
+            appendValue(encoded, field.uintValue);
+        }
+    }
+
+    uint32_t bodySize = static_cast<uint32_t>(encoded.size() - RECORD_HEADER_SIZE);
+    uint32_t crc = logCrc32c(encoded.data() + RECORD_HEADER_SIZE, bodySize);
+    std::memcpy(&encoded[0], &bodySize, sizeof(bodySize));
+    std::memcpy(&encoded[4], &crc, sizeof(crc));
+
+    std::lock_guard<std::mutex> lock(appendMutex);
+    if (fd < 0)
+    {
+        return false;
+    }
+    uint64_t end = writeEnd.load(std::memory_order_relaxed);
+    if (!writeAll(fd, encoded.data(), encoded.size()))
+    {
+        // Drop a partial record so the next one starts at a record boundary
+        int truncated = ::ftruncate(fd, static_cast<off_t>(end));
+        (void)truncated;
+        return false;
+    }
+    writeEnd.store(end + encoded.size(), std::memory_order_release);
+    return true;
+}
+
+bool SpillFile::load(uint64_t offset, size_t size, uint64_t limit)
+{
+    if (offset + size > limit)
+    {
+        return false;
+    }
+    if (offset >= readBufferOffset && offset + size <= readBufferOffset + readBuffer.size())
+    {
+        return true;
+    }
+
+    size_t wanted = static_cast<size_t>(std::min<uint64_t>(std::max(size, READ_CHUNK), limit - offset));
+    readBuffer.resize(wanted);
+    readBufferOffset = offset;
+    size_t filled = 0;
+    while (filled < wanted)
+    {
+        ssize_t got = ::pread(fd, &readBuffer[filled], wanted - filled, static_cast<off_t>(offset + filled));
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            break;
+        }
+        filled += static_cast<size_t>(got);
+    }
+    readBuffer.resize(filled);
+    return filled >= size;
+}
+
+bool SpillFile::parse(const char *body, size_t size)
+{
+    BodyReader reader(body, size);
+    head.timestampNs = reader.value<int64_t>();
+    head.threadId = reader.value<uint64_t>();
+    head.source = reader.value<uint64_t>();
+    head.lineNumber = reader.value<int32_t>();
+    uint8_t level = reader.value<uint8_t>();
+    head.level = static_cast<LogLevel>(level <= static_cast<uint8_t>(LogLevel::ERROR) ? level : 0);
+    head.file = reader.text();
+    head.function = reader.text();
+    head.threadName = reader.text();
+    head.message = reader.text();
+
+    uint32_t fieldCount = reader.value<uint32_t>();
+    headFields.clear();
+    for (uint32_t i = 0; i < fieldCount && reader.ok(); ++i)
+    {
+        LogField field;
+        field.key = reader.text();
+        field.type = static_cast<LogFieldType>(reader.value<uint8_t>());
+        field.uintValue = 0;
+        if (field.type == LogFieldType::STRING)
+        {
+            field.stringValue = reader.text();
+        }
+        else
+        {
+            field.uintValue = reader.value<uint64_t>();
+        }
+        headFields.push_back(field);
+    }
+    head.fields = headFields.data();
+    head.fieldCount = headFields.size();
+    return reader.ok() && reader.atEnd();
+}
+
+const SpilledRecord *SpillFile::peek(uint64_t limit)
+{
+    while (!headValid)
+    {
+        if (fd < 0 || !load(readCursor, RECORD_HEADER_SIZE, limit))
+        {
+            return nullptr;
+        }
+        uint32_t bodySize;
+        uint32_t crc;
+        std::memcpy(&bodySize, readBuffer.data() + (readCursor - readBufferOffset), sizeof(bodySize));
+        std::memcpy(&crc, readBuffer.data() + (readCursor - readBufferOffset) + 4, sizeof(crc));
+        headSize = RECORD_HEADER_SIZE + bodySize;
+        if (!load(readCursor, headSize, limit))
+        {
+            return nullptr;
+        }
+
+        const char *body = readBuffer.data() + (readCursor - readBufferOffset) + RECORD_HEADER_SIZE;
+        if (logCrc32c(body, bodySize) != crc || !parse(body, bodySize))
+        {
+            // Damaged on disk: skip the record rather than stall the queue
+            readCursor += headSize;
+            continue;
+        }
+        head.recovered = readCursor < recoveredEnd;
+        headValid = true;
+    }
+    return &head;
+}
+
+void SpillFile::advance()
+{
+    readCursor += headSize;
+    headValid = false;
+}
+
+void SpillFile::compact()
+{
+    std::lock_guard<std::mutex> lock(appendMutex);
+    uint64_t end = writeEnd.load(std::memory_order_relaxed);
+    if (fd < 0 || headValid || end == 0 || readCursor != end)
+    {
+        return;
+    }
+    if (::ftruncate(fd, 0) == 0)
+    {
+        writeEnd.store(0, std::memory_order_release);
+        readCursor = 0;
+        recoveredEnd = 0;
+        readBuffer.clear();
+        readBufferOffset = 0;
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Logger.hpp"
+
+// One record as stored in the spill file. Text fields reference the reader's
+// buffer (or the producer's data when appending) and are NUL-terminated.
+struct SpilledRecord
+{
+    LogLevel level;
+    int64_t timestampNs;
+    int lineNumber;
+    uint64_t threadId;
+    uint64_t source; // Producing RecordSlab; meaningless when recovered
+    LogStringRef file;
+    LogStringRef function;
+    LogStringRef threadName;
+    LogStringRef message;
+    const LogField *fields;
+    size_t fieldCount;
+    bool recovered; // Written by an earlier process
+};
+
+/**
+ * SpillFile - Append-only overflow queue on disk for the asynchronous backend
+ *
+ * Producers whose slab is full append records here instead of waiting; the
+ * backend reads them back in file order, merged with the slabs by timestamp.
+ * Records carry their strings rather than pointers, so records left by a
+ * process that died are replayed by the next one. Each record is framed as
+ * length + CRC32C + body; a torn last record is cut off when opening.
+ *
+ * Once everything has been read back the file is truncated, so disk use
+ * only grows while the backend is behind.
+ */
+class SpillFile
+{
+public:
+    SpillFile();
+    ~SpillFile();
+
+    SpillFile(const SpillFile &) = delete;
+    SpillFile &operator=(const SpillFile &) = delete;
+
+    // Open or create the file, keeping intact records from an earlier process
+    bool open(const std::string &path);
+
+    // Close the file, deleting it if every record was read back
+    void close();
+
+    // ---- Producer side (thread-safe) ----
+
+    // Append one record; false if it could not be written
+    bool append(const SpilledRecord &record);
+
+    // ---- Consumer side (backend thread) ----
+
+    // End of the records appended so far
+    uint64_t published() const { return writeEnd.load(std::memory_order_acquire); }
+
+    // Next record before `limit`; nullptr if none. Valid until advance().
+    const SpilledRecord *peek(uint64_t limit);
+
+    // Step past the record returned by peek()
+    void advance();
+
+    // Truncate the file if every record has been read back
+    void compact();
+
+private:
+    std::string path;
+    int fd;
+
+    std::mutex appendMutex;
+    std::atomic<uint64_t> writeEnd;
+
+    // Consumer state
+    uint64_t readCursor;
+    uint64_t recoveredEnd; // Records before this offset came from an earlier process
+    std::string readBuffer;
+    uint64_t readBufferOffset;
+    bool headValid;
+    size_t headSize;
+    SpilledRecord head;
+    std::vector<LogField> headFields;
+
+    bool load(uint64_t offset, size_t size, uint64_t limit);
+    bool parse(const char *body, size_t size);
+    size_t validPrefix();
+};
@@ -10,7 +10,7 @@ echo ""
 
 # Configuration
 COMPILER="g++"
-CPPFLAGS="-std=c++14 -Wall -Wextra -fPIC"
+CPPFLAGS="-std=c++14 -Wall -Wextra -fPIC -pthread"
 OPTIMIZATION="-O2"
 INCLUDE_DIR="./Includes"
 SRC_DIR="./Src"
@@ -26,6 +26,18 @@ SOURCES=(
     "$SRC_DIR/Logger.cpp"
     "$SRC_DIR/Logger_C.cpp"
     "$SRC_DIR/FileRotatingHandler.cpp"
+    "$SRC_DIR/RecordSlab.cpp"
+    "$SRC_DIR/NumaTopology.cpp"
+    "$SRC_DIR/LogMemoryResource.cpp"
+    "$SRC_DIR/BinaryLogFormat.cpp"
+    "$SRC_DIR/LogFraming.cpp"
+    "$SRC_DIR/LogCompression.cpp"
+    "$SRC_DIR/SpillFile.cpp"
+    "$SRC_DIR/LogRedactor.cpp"
+    "$SRC_DIR/LogSanitizer.cpp"
+    "$SRC_DIR/SignalQueue.cpp"
+    "$SRC_DIR/ChromeTraceHandler.cpp"
+    "$SRC_DIR/MemoryRingHandler.cpp"
 )
 
 # Create lib directory